@@ -0,0 +1,98 @@
+// Polygon union and intersection of two overlapping regular polygons with
+// n vertices each, through the C API (per pair and batched) and S2Polygon
+// directly.
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "bench_util.h"
+
+using s2c_bench::kMaxSize;
+using s2c_bench::kMinSize;
+
+namespace {
+
+// The second polygon is shifted so the two overlap by about half
+constexpr double kOffsetDegrees = 5.0;
+
+void BM_PolygonUnion_CApi(benchmark::State& state) {
+    auto a = s2c_bench::MakePolygon(state.range(0));
+    auto b = s2c_bench::MakePolygon(state.range(0), 0.0, kOffsetDegrees);
+    S2CPolygon* inputs[2] = {s2c_bench::ToHandle(*a), s2c_bench::ToHandle(*b)};
+    for (auto _ : state) {
+        S2CPolygon* result = s2c_polygon_new();
+        s2c_polygon_init_to_union(result, inputs, 2);
+        benchmark::DoNotOptimize(s2c_polygon_num_vertices(result));
+        s2c_polygon_destroy(result);
+    }
+    s2c_polygon_destroy(inputs[0]);
+    s2c_polygon_destroy(inputs[1]);
+    state.SetItemsProcessed(state.iterations() * 2 * state.range(0));
+}
+BENCHMARK(BM_PolygonUnion_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_PolygonUnion_Cpp(benchmark::State& state) {
+    auto a = s2c_bench::MakePolygon(state.range(0));
+    auto b = s2c_bench::MakePolygon(state.range(0), 0.0, kOffsetDegrees);
+    for (auto _ : state) {
+        S2Polygon result;
+        result.InitToUnion(*a, *b);
+        benchmark::DoNotOptimize(result.num_vertices());
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * state.range(0));
+}
+BENCHMARK(BM_PolygonUnion_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_PolygonIntersection_CApi(benchmark::State& state) {
+    auto a = s2c_bench::MakePolygon(state.range(0));
+    auto b = s2c_bench::MakePolygon(state.range(0), 0.0, kOffsetDegrees);
+    S2CPolygon* clip = s2c_bench::ToHandle(*a);
+    S2CPolygon* other = s2c_bench::ToHandle(*b);
+    for (auto _ : state) {
+        S2CPolygon* result = s2c_polygon_new();
+        s2c_polygon_init_to_intersection(result, clip, other);
+        benchmark::DoNotOptimize(s2c_polygon_num_vertices(result));
+        s2c_polygon_destroy(result);
+    }
+    s2c_polygon_destroy(other);
+    s2c_polygon_destroy(clip);
+    state.SetItemsProcessed(state.iterations() * 2 * state.range(0));
+}
+BENCHMARK(BM_PolygonIntersection_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+// Clips kBatchSize shifted copies of the second polygon in one batch call
+constexpr int kBatchSize = 16;
+
+void BM_PolygonIntersection_Batch(benchmark::State& state) {
+    auto a = s2c_bench::MakePolygon(state.range(0));
+    S2CPolygon* clip = s2c_bench::ToHandle(*a);
+    S2CPolygon* others[kBatchSize];
+    for (int i = 0; i < kBatchSize; i++) {
+        auto b = s2c_bench::MakePolygon(state.range(0), 0.1 * i, kOffsetDegrees);
+        others[i] = s2c_bench::ToHandle(*b);
+    }
+    S2CPolygon* results[kBatchSize];
+    for (auto _ : state) {
+        int count = s2c_polygon_intersection_batch(clip, others, kBatchSize, nullptr, results);
+        benchmark::DoNotOptimize(count);
+        for (S2CPolygon* result : results) s2c_polygon_destroy(result);
+    }
+    for (S2CPolygon* other : others) s2c_polygon_destroy(other);
+    s2c_polygon_destroy(clip);
+    state.SetItemsProcessed(state.iterations() * 2 * kBatchSize * state.range(0));
+}
+BENCHMARK(BM_PolygonIntersection_Batch)->RangeMultiplier(8)->Range(kMinSize, kMaxSize)->UseRealTime();
+
+void BM_PolygonIntersection_Cpp(benchmark::State& state) {
+    auto a = s2c_bench::MakePolygon(state.range(0));
+    auto b = s2c_bench::MakePolygon(state.range(0), 0.0, kOffsetDegrees);
+    for (auto _ : state) {
+        S2Polygon result;
+        result.InitToIntersection(*a, *b);
+        benchmark::DoNotOptimize(result.num_vertices());
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * state.range(0));
+}
+BENCHMARK(BM_PolygonIntersection_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+}  // namespace
@@ -0,0 +1,106 @@
+// Region coverings of n caps: one C API call per cap, the batch API on one
+// thread and on the shared pool, and S2RegionCoverer directly.
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "bench_util.h"
+#include "s2/s2cap.h"
+#include "s2/s2cell_id.h"
+#include "s2/s2region_coverer.h"
+
+using s2c_bench::kMaxSize;
+using s2c_bench::kMinSize;
+
+namespace {
+
+constexpr int kMaxCells = 16;
+constexpr double kCapRadiusDegrees = 0.5;
+
+std::vector<S2Cap> RandomCaps(int n) {
+    std::vector<S2Cap> caps;
+    caps.reserve(n);
+    for (const S2Point& center : s2c_bench::RandomPoints(n)) {
+        caps.push_back(S2Cap(center, S1Angle::Degrees(kCapRadiusDegrees)));
+    }
+    return caps;
+}
+
+std::vector<S2CCap*> RandomCapHandles(int n) {
+    std::vector<S2CCap*> caps;
+    caps.reserve(n);
+    for (const S2Cap& cap : RandomCaps(n)) {
+        const S2Point& c = cap.center();
+        S2CPoint* center = s2c_point_new(c.x(), c.y(), c.z());
+        caps.push_back(s2c_cap_from_center_height(center, cap.height()));
+        s2c_point_destroy(center);
+    }
+    return caps;
+}
+
+void DestroyCapHandles(const std::vector<S2CCap*>& caps) {
+    for (S2CCap* cap : caps) s2c_cap_destroy(cap);
+}
+
+void BM_CapCovering_CApi(benchmark::State& state) {
+    auto caps = RandomCapHandles(state.range(0));
+    S2CRegionCoverer* coverer = s2c_regioncoverer_new();
+    s2c_regioncoverer_set_max_cells(coverer, kMaxCells);
+    for (auto _ : state) {
+        for (const S2CCap* cap : caps) {
+            S2CCellId** covering = nullptr;
+            int count = 0;
+            s2c_regioncoverer_get_covering_cap(coverer, cap, &covering, &count);
+            benchmark::DoNotOptimize(count);
+            s2c_free_cellid_array(covering, count);
+        }
+    }
+    s2c_regioncoverer_destroy(coverer);
+    DestroyCapHandles(caps);
+    state.SetItemsProcessed(state.iterations() * caps.size());
+}
+BENCHMARK(BM_CapCovering_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void CapCoveringBatch(benchmark::State& state, int num_threads) {
+    auto caps = RandomCapHandles(state.range(0));
+    std::vector<S2CRegionRef> regions;
+    for (const S2CCap* cap : caps) regions.push_back({S2C_REGION_CAP, cap});
+    S2CRegionCoverer* coverer = s2c_regioncoverer_new();
+    s2c_regioncoverer_set_max_cells(coverer, kMaxCells);
+    for (auto _ : state) {
+        uint64_t* ids = nullptr;
+        int64_t* offsets = nullptr;
+        benchmark::DoNotOptimize(s2c_regioncoverer_get_coverings_batch(
+            coverer, regions.data(), regions.size(), false, num_threads, &ids, &offsets));
+        s2c_free_buffer(ids);
+        s2c_free_buffer(offsets);
+    }
+    s2c_regioncoverer_destroy(coverer);
+    DestroyCapHandles(caps);
+    state.SetItemsProcessed(state.iterations() * caps.size());
+}
+
+void BM_CapCovering_Batch(benchmark::State& state) { CapCoveringBatch(state, 1); }
+BENCHMARK(BM_CapCovering_Batch)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_CapCovering_BatchParallel(benchmark::State& state) { CapCoveringBatch(state, 0); }
+BENCHMARK(BM_CapCovering_BatchParallel)->RangeMultiplier(8)->Range(kMinSize, kMaxSize)->UseRealTime();
+
+void BM_CapCovering_Cpp(benchmark::State& state) {
+    auto caps = RandomCaps(state.range(0));
+    S2RegionCoverer::Options options;
+    options.set_max_cells(kMaxCells);
+    S2RegionCoverer coverer(options);
+    std::vector<S2CellId> covering;
+    for (auto _ : state) {
+        for (const S2Cap& cap : caps) {
+            coverer.GetCovering(cap, &covering);
+            benchmark::DoNotOptimize(covering.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * caps.size());
+}
+BENCHMARK(BM_CapCovering_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+}  // namespace
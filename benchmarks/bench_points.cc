@@ -0,0 +1,200 @@
+// Point, lat/lng and cell id conversions: per-handle C API, arena and batch
+// variants against the equivalent direct C++ calls.
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "s2/s2cell_id.h"
+
+using s2c_bench::kMaxSize;
+using s2c_bench::kMinSize;
+
+namespace {
+
+constexpr int kParentLevel = 10;
+
+void BM_LatLngToPoint_CApi(benchmark::State& state) {
+    auto latlngs = s2c_bench::RandomLatLngs(state.range(0));
+    for (auto _ : state) {
+        for (const S2LatLng& ll : latlngs) {
+            S2CLatLng* latlng = s2c_latlng_from_degrees(ll.lat().degrees(), ll.lng().degrees());
+            S2CPoint* point = s2c_latlng_to_point(latlng);
+            double x, y, z;
+            s2c_point_get_coords(point, &x, &y, &z);
+            benchmark::DoNotOptimize(x + y + z);
+            s2c_point_destroy(point);
+            s2c_latlng_destroy(latlng);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * latlngs.size());
+}
+BENCHMARK(BM_LatLngToPoint_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_LatLngToPoint_Arena(benchmark::State& state) {
+    auto latlngs = s2c_bench::RandomLatLngs(state.range(0));
+    S2CArena* arena = s2c_arena_new(0);
+    for (auto _ : state) {
+        for (const S2LatLng& ll : latlngs) {
+            S2CLatLng* latlng = s2c_latlng_from_degrees_arena(arena, ll.lat().degrees(), ll.lng().degrees());
+            S2CPoint* point = s2c_latlng_to_point_arena(arena, latlng);
+            double x, y, z;
+            s2c_point_get_coords(point, &x, &y, &z);
+            benchmark::DoNotOptimize(x + y + z);
+        }
+        s2c_arena_reset(arena);
+    }
+    s2c_arena_destroy(arena);
+    state.SetItemsProcessed(state.iterations() * latlngs.size());
+}
+BENCHMARK(BM_LatLngToPoint_Arena)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_LatLngToPoint_Cpp(benchmark::State& state) {
+    auto latlngs = s2c_bench::RandomLatLngs(state.range(0));
+    for (auto _ : state) {
+        for (const S2LatLng& ll : latlngs) {
+            S2Point point = S2LatLng::FromDegrees(ll.lat().degrees(), ll.lng().degrees()).ToPoint();
+            benchmark::DoNotOptimize(point);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * latlngs.size());
+}
+BENCHMARK(BM_LatLngToPoint_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_PointToLatLng_CApi(benchmark::State& state) {
+    auto points = s2c_bench::ToHandles(s2c_bench::RandomPoints(state.range(0)));
+    for (auto _ : state) {
+        for (const S2CPoint* point : points) {
+            S2CLatLng* latlng = s2c_latlng_from_point(point);
+            benchmark::DoNotOptimize(s2c_latlng_lat_degrees(latlng) + s2c_latlng_lng_degrees(latlng));
+            s2c_latlng_destroy(latlng);
+        }
+    }
+    s2c_bench::DestroyHandles(points);
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PointToLatLng_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_PointToLatLng_Cpp(benchmark::State& state) {
+    auto points = s2c_bench::RandomPoints(state.range(0));
+    for (auto _ : state) {
+        for (const S2Point& point : points) {
+            S2LatLng latlng(point);
+            benchmark::DoNotOptimize(latlng.lat().degrees() + latlng.lng().degrees());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PointToLatLng_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_CellIdFromPoint_CApi(benchmark::State& state) {
+    auto points = s2c_bench::ToHandles(s2c_bench::RandomPoints(state.range(0)));
+    for (auto _ : state) {
+        for (const S2CPoint* point : points) {
+            S2CCellId* cellid = s2c_cellid_from_point(point);
+            benchmark::DoNotOptimize(s2c_cellid_id(cellid));
+            s2c_cellid_destroy(cellid);
+        }
+    }
+    s2c_bench::DestroyHandles(points);
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_CellIdFromPoint_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_CellIdFromPoint_Cpp(benchmark::State& state) {
+    auto points = s2c_bench::RandomPoints(state.range(0));
+    for (auto _ : state) {
+        for (const S2Point& point : points) {
+            benchmark::DoNotOptimize(S2CellId(point).id());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_CellIdFromPoint_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+std::vector<uint64_t> RandomCellIds(int n) {
+    std::vector<uint64_t> ids;
+    ids.reserve(n);
+    for (const S2Point& point : s2c_bench::RandomPoints(n)) ids.push_back(S2CellId(point).id());
+    return ids;
+}
+
+void BM_CellIdParent_CApi(benchmark::State& state) {
+    auto ids = RandomCellIds(state.range(0));
+    for (auto _ : state) {
+        for (uint64_t id : ids) {
+            S2CCellId* cellid = s2c_cellid_new(id);
+            S2CCellId* parent = s2c_cellid_parent(cellid, kParentLevel);
+            benchmark::DoNotOptimize(s2c_cellid_id(parent));
+            s2c_cellid_destroy(parent);
+            s2c_cellid_destroy(cellid);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_CellIdParent_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_CellIdParent_Batch(benchmark::State& state) {
+    auto ids = RandomCellIds(state.range(0));
+    std::vector<uint64_t> parents(ids.size());
+    for (auto _ : state) {
+        s2c_cellid_parent_batch(ids.data(), ids.size(), kParentLevel, parents.data());
+        benchmark::DoNotOptimize(parents.data());
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_CellIdParent_Batch)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_CellIdParent_Cpp(benchmark::State& state) {
+    auto ids = RandomCellIds(state.range(0));
+    for (auto _ : state) {
+        for (uint64_t id : ids) {
+            benchmark::DoNotOptimize(S2CellId(id).parent(kParentLevel).id());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_CellIdParent_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_CellIdToToken_CApi(benchmark::State& state) {
+    auto ids = RandomCellIds(state.range(0));
+    for (auto _ : state) {
+        for (uint64_t id : ids) {
+            S2CCellId* cellid = s2c_cellid_new(id);
+            char* token = s2c_cellid_to_token(cellid);
+            benchmark::DoNotOptimize(token[0]);
+            s2c_free_string(token);
+            s2c_cellid_destroy(cellid);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_CellIdToToken_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_CellIdToToken_Batch(benchmark::State& state) {
+    auto ids = RandomCellIds(state.range(0));
+    std::vector<char> bytes(16 * ids.size());
+    std::vector<int64_t> offsets(ids.size() + 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            s2c_cellid_to_tokens_packed(ids.data(), ids.size(), bytes.data(), offsets.data(), 1));
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_CellIdToToken_Batch)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_CellIdToToken_Cpp(benchmark::State& state) {
+    auto ids = RandomCellIds(state.range(0));
+    for (auto _ : state) {
+        for (uint64_t id : ids) {
+            std::string token = S2CellId(id).ToToken();
+            benchmark::DoNotOptimize(token.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_CellIdToToken_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+}  // namespace
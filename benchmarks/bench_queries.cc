@@ -0,0 +1,222 @@
+// Shape index build and point/edge queries: per-handle C API and batch
+// variants against MutableS2ShapeIndex and the S2 query classes directly.
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bench_util.h"
+#include "s2/mutable_s2shape_index.h"
+#include "s2/s2closest_edge_query.h"
+#include "s2/s2contains_point_query.h"
+#include "s2/s2crossing_edge_query.h"
+#include "s2/s2edge_crossings.h"
+
+using s2c_bench::kMaxSize;
+using s2c_bench::kMinSize;
+
+namespace {
+
+// Queries run against one polygon of this many vertices
+constexpr int kIndexVertices = 1024;
+
+void BM_IndexBuild_CApi(benchmark::State& state) {
+    auto polygon = s2c_bench::MakePolygon(state.range(0));
+    S2CPolygon* handle = s2c_bench::ToHandle(*polygon);
+    for (auto _ : state) {
+        S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+        s2c_mutable_shape_index_add_polygon(index, handle);
+        s2c_mutable_shape_index_force_build(index);
+        s2c_mutable_shape_index_destroy(index);
+    }
+    s2c_polygon_destroy(handle);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IndexBuild_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_IndexBuild_Cpp(benchmark::State& state) {
+    auto polygon = s2c_bench::MakePolygon(state.range(0));
+    for (auto _ : state) {
+        MutableS2ShapeIndex index;
+        index.Add(std::make_unique<S2Polygon::Shape>(polygon.get()));
+        index.ForceBuild();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IndexBuild_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+// Many small clustered polygons rather than one large one
+void BM_IndexBuildParcels_CApi(benchmark::State& state) {
+    std::vector<S2CPolygon*> handles;
+    for (const auto& polygon : s2c_bench::GeneratedPolygons(state.range(0))) {
+        handles.push_back(s2c_bench::ToHandle(*polygon));
+    }
+    for (auto _ : state) {
+        S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+        for (S2CPolygon* handle : handles) s2c_mutable_shape_index_add_polygon(index, handle);
+        s2c_mutable_shape_index_force_build(index);
+        s2c_mutable_shape_index_destroy(index);
+    }
+    for (S2CPolygon* handle : handles) s2c_polygon_destroy(handle);
+    state.SetItemsProcessed(state.iterations() * handles.size());
+}
+BENCHMARK(BM_IndexBuildParcels_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_IndexBuildParcels_Cpp(benchmark::State& state) {
+    auto polygons = s2c_bench::GeneratedPolygons(state.range(0));
+    for (auto _ : state) {
+        MutableS2ShapeIndex index;
+        for (const auto& polygon : polygons) index.Add(std::make_unique<S2Polygon::Shape>(polygon.get()));
+        index.ForceBuild();
+    }
+    state.SetItemsProcessed(state.iterations() * polygons.size());
+}
+BENCHMARK(BM_IndexBuildParcels_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+// Owns the C API index and its C++ twin for the query benchmarks
+struct QueryFixture {
+    std::unique_ptr<S2Polygon> polygon = s2c_bench::MakePolygon(kIndexVertices);
+    S2CPolygon* handle = s2c_bench::ToHandle(*polygon);
+    S2CMutableShapeIndex* c_index = s2c_mutable_shape_index_new();
+    MutableS2ShapeIndex index;
+
+    QueryFixture() {
+        s2c_mutable_shape_index_add_polygon(c_index, handle);
+        s2c_mutable_shape_index_force_build(c_index);
+        index.Add(std::make_unique<S2Polygon::Shape>(polygon.get()));
+        index.ForceBuild();
+    }
+    ~QueryFixture() {
+        s2c_mutable_shape_index_destroy(c_index);
+        s2c_polygon_destroy(handle);
+    }
+};
+
+void BM_ContainsPoint_CApi(benchmark::State& state) {
+    QueryFixture fixture;
+    auto points = s2c_bench::ToHandles(s2c_bench::RandomPoints(state.range(0)));
+    S2CContainsPointQuery* query = s2c_contains_point_query_new_mutable(fixture.c_index);
+    for (auto _ : state) {
+        for (const S2CPoint* point : points) {
+            benchmark::DoNotOptimize(s2c_contains_point_query_contains(query, point));
+        }
+    }
+    s2c_contains_point_query_destroy(query);
+    s2c_bench::DestroyHandles(points);
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_ContainsPoint_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_ContainsPoint_Batch(benchmark::State& state) {
+    QueryFixture fixture;
+    auto xyz = s2c_bench::ToXyz(s2c_bench::RandomPoints(state.range(0)));
+    std::vector<uint8_t> inside(state.range(0));
+    for (auto _ : state) {
+        s2c_contains_point_query_batch(fixture.c_index, xyz.data(), inside.size(), nullptr, inside.data());
+        benchmark::DoNotOptimize(inside.data());
+    }
+    state.SetItemsProcessed(state.iterations() * inside.size());
+}
+BENCHMARK(BM_ContainsPoint_Batch)->RangeMultiplier(8)->Range(kMinSize, kMaxSize)->UseRealTime();
+
+void BM_ContainsPoint_Cpp(benchmark::State& state) {
+    QueryFixture fixture;
+    auto points = s2c_bench::RandomPoints(state.range(0));
+    auto query = MakeS2ContainsPointQuery(&fixture.index);
+    for (auto _ : state) {
+        for (const S2Point& point : points) {
+            benchmark::DoNotOptimize(query.Contains(point));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_ContainsPoint_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_ClosestEdge_CApi(benchmark::State& state) {
+    QueryFixture fixture;
+    auto points = s2c_bench::ToHandles(s2c_bench::RandomPoints(state.range(0)));
+    S2CClosestEdgeQuery* query = s2c_closest_edge_query_new_mutable(fixture.c_index);
+    for (auto _ : state) {
+        for (const S2CPoint* point : points) {
+            S2CClosestEdgeResult* result = s2c_closest_edge_query_find_closest_edge(query, point);
+            benchmark::DoNotOptimize(s2c_closest_edge_result_edge_id(result));
+            s2c_closest_edge_result_destroy(result);
+        }
+    }
+    s2c_closest_edge_query_destroy(query);
+    s2c_bench::DestroyHandles(points);
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_ClosestEdge_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_ClosestEdge_Batch(benchmark::State& state) {
+    QueryFixture fixture;
+    auto xyz = s2c_bench::ToXyz(s2c_bench::RandomPoints(state.range(0)));
+    std::vector<int32_t> shape_ids(state.range(0));
+    std::vector<int32_t> edge_ids(state.range(0));
+    std::vector<double> distances(state.range(0));
+    for (auto _ : state) {
+        s2c_closest_edge_query_batch(fixture.c_index, xyz.data(), shape_ids.size(), nullptr,
+                                     shape_ids.data(), edge_ids.data(), distances.data());
+        benchmark::DoNotOptimize(edge_ids.data());
+    }
+    state.SetItemsProcessed(state.iterations() * shape_ids.size());
+}
+BENCHMARK(BM_ClosestEdge_Batch)->RangeMultiplier(8)->Range(kMinSize, kMaxSize)->UseRealTime();
+
+void BM_ClosestEdge_Cpp(benchmark::State& state) {
+    QueryFixture fixture;
+    auto points = s2c_bench::RandomPoints(state.range(0));
+    S2ClosestEdgeQuery query(&fixture.index);
+    for (auto _ : state) {
+        for (const S2Point& point : points) {
+            S2ClosestEdgeQuery::PointTarget target(point);
+            benchmark::DoNotOptimize(query.FindClosestEdge(&target).edge_id());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_ClosestEdge_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+// Edges between consecutive random points, many of which cross the polygon
+void BM_CrossingEdge_CApi(benchmark::State& state) {
+    QueryFixture fixture;
+    auto points = s2c_bench::ToHandles(s2c_bench::RandomPoints(state.range(0) + 1));
+    S2CCrossingEdgeQuery* query = s2c_crossing_edge_query_new_mutable(fixture.c_index);
+    for (auto _ : state) {
+        for (size_t i = 0; i + 1 < points.size(); i++) {
+            benchmark::DoNotOptimize(s2c_crossing_edge_query_edge_intersects(query, points[i], points[i + 1]));
+        }
+    }
+    s2c_crossing_edge_query_destroy(query);
+    s2c_bench::DestroyHandles(points);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CrossingEdge_CApi)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+// Same work as s2c_crossing_edge_query_edge_intersects: candidates, then
+// CrossingSign until the first edge that crosses or touches
+bool EdgeIntersects(S2CrossingEdgeQuery& query, const MutableS2ShapeIndex& index, const S2Point& a0,
+                    const S2Point& a1) {
+    for (const s2shapeutil::ShapeEdgeId& id : query.GetCandidates(a0, a1)) {
+        S2Shape::Edge edge = index.shape(id.shape_id)->edge(id.edge_id);
+        if (S2::CrossingSign(a0, a1, edge.v0, edge.v1) >= 0) return true;
+    }
+    return false;
+}
+
+void BM_CrossingEdge_Cpp(benchmark::State& state) {
+    QueryFixture fixture;
+    auto points = s2c_bench::RandomPoints(state.range(0) + 1);
+    S2CrossingEdgeQuery query(&fixture.index);
+    for (auto _ : state) {
+        for (size_t i = 0; i + 1 < points.size(); i++) {
+            benchmark::DoNotOptimize(EdgeIntersects(query, fixture.index, points[i], points[i + 1]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CrossingEdge_Cpp)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+}  // namespace
@@ -0,0 +1,114 @@
+// Shared inputs for the S2C benchmarks. Every generator uses a fixed seed so
+// the C API and direct C++ variants of a benchmark see identical inputs.
+#ifndef S2C_BENCH_UTIL_H
+#define S2C_BENCH_UTIL_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "s2/s1angle.h"
+#include "s2/s2latlng.h"
+#include "s2/s2loop.h"
+#include "s2/s2point.h"
+#include "s2/s2polygon.h"
+#include "s2/util/coding/coder.h"
+#include "s2c.h"
+
+namespace s2c_bench {
+
+// Benchmark sizes: 64 .. 32768 in steps of 8x
+constexpr int kMinSize = 64;
+constexpr int kMaxSize = 1 << 15;
+
+// Uniform lat/lngs in a 20x20 degree box centered on (0, 0), which covers
+// the polygons from MakePolygon so queries hit both inside and outside.
+inline std::vector<S2LatLng> RandomLatLngs(int n, uint32_t seed = 1) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coord(-10.0, 10.0);
+    std::vector<S2LatLng> latlngs;
+    latlngs.reserve(n);
+    for (int i = 0; i < n; i++) {
+        double lat = coord(rng);
+        latlngs.push_back(S2LatLng::FromDegrees(lat, coord(rng)));
+    }
+    return latlngs;
+}
+
+inline std::vector<S2Point> RandomPoints(int n, uint32_t seed = 1) {
+    std::vector<S2Point> points;
+    points.reserve(n);
+    for (const S2LatLng& latlng : RandomLatLngs(n, seed)) points.push_back(latlng.ToPoint());
+    return points;
+}
+
+// Flat xyz buffer for the batch APIs
+inline std::vector<double> ToXyz(const std::vector<S2Point>& points) {
+    std::vector<double> xyz;
+    xyz.reserve(3 * points.size());
+    for (const S2Point& p : points) {
+        xyz.push_back(p.x());
+        xyz.push_back(p.y());
+        xyz.push_back(p.z());
+    }
+    return xyz;
+}
+
+// Caller owns the returned handles
+inline std::vector<S2CPoint*> ToHandles(const std::vector<S2Point>& points) {
+    std::vector<S2CPoint*> handles;
+    handles.reserve(points.size());
+    for (const S2Point& p : points) handles.push_back(s2c_point_new(p.x(), p.y(), p.z()));
+    return handles;
+}
+
+inline void DestroyHandles(const std::vector<S2CPoint*>& handles) {
+    for (S2CPoint* point : handles) s2c_point_destroy(point);
+}
+
+// Regular polygon with num_vertices vertices and a 5 degree radius
+inline std::unique_ptr<S2Polygon> MakePolygon(int num_vertices, double lat = 0.0, double lng = 0.0) {
+    auto loop = S2Loop::MakeRegularLoop(S2LatLng::FromDegrees(lat, lng).ToPoint(), S1Angle::Degrees(5),
+                                        num_vertices);
+    return std::make_unique<S2Polygon>(std::move(loop));
+}
+
+// Copies a polygon into an S2C handle through its encoding. Aborts if the
+// copy does not round-trip, since timing an empty handle measures nothing.
+inline S2CPolygon* ToHandle(const S2Polygon& polygon) {
+    Encoder encoder;
+    polygon.Encode(&encoder);
+    S2CPolygon* handle = s2c_polygon_new();
+    if (!s2c_polygon_decode(handle, encoder.base(), encoder.length()) ||
+        s2c_polygon_num_vertices(handle) != polygon.num_vertices()) {
+        std::fprintf(stderr, "ToHandle: failed to copy a %d-vertex polygon\n", polygon.num_vertices());
+        std::abort();
+    }
+    return handle;
+}
+
+// Clustered fractal parcels from the workload generator (fixed seed)
+inline std::vector<std::unique_ptr<S2Polygon>> GeneratedPolygons(int n, int num_vertices = 16) {
+    S2CGenerator* generator = s2c_generator_new(1);
+    s2c_generator_set_region(generator, 0.0, 0.0, 10.0);
+    s2c_generator_set_clustering(generator, 8, 1.0);
+    char* bytes = nullptr;
+    int64_t* offsets = nullptr;
+    int count = s2c_generate_polygons_encoded(generator, n, num_vertices, 1, 0.01, 0.5, &bytes, &offsets);
+    std::vector<std::unique_ptr<S2Polygon>> polygons;
+    for (int i = 0; i < count; i++) {
+        Decoder decoder(bytes + offsets[i], offsets[i + 1] - offsets[i]);
+        auto polygon = std::make_unique<S2Polygon>();
+        if (polygon->Decode(&decoder)) polygons.push_back(std::move(polygon));
+    }
+    s2c_free_buffer(bytes);
+    s2c_free_buffer(offsets);
+    s2c_generator_destroy(generator);
+    return polygons;
+}
+
+}  // namespace s2c_bench
+
+#endif  // S2C_BENCH_UTIL_H
@@ -10,9 +10,50 @@ extern "C" {
 #endif
 
 // Error handling
+// Numeric codes mirror S2Error::Code and are stable across releases
+typedef enum {
+    S2C_ERROR_OK = 0,
+    S2C_ERROR_NOT_UNIT_LENGTH = 1,
+    S2C_ERROR_DUPLICATE_VERTICES = 2,
+    S2C_ERROR_ANTIPODAL_VERTICES = 3,
+    S2C_ERROR_NOT_CONTINUOUS = 4,
+    S2C_ERROR_INVALID_VERTEX = 5,
+    S2C_ERROR_LOOP_NOT_ENOUGH_VERTICES = 100,
+    S2C_ERROR_LOOP_SELF_INTERSECTION = 101,
+    S2C_ERROR_POLYGON_LOOPS_SHARE_EDGE = 200,
+    S2C_ERROR_POLYGON_LOOPS_CROSS = 201,
+    S2C_ERROR_POLYGON_EMPTY_LOOP = 202,
+    S2C_ERROR_POLYGON_EXCESS_FULL_LOOP = 203,
+    S2C_ERROR_POLYGON_INCONSISTENT_LOOP_ORIENTATIONS = 204,
+    S2C_ERROR_POLYGON_INVALID_LOOP_DEPTH = 205,
+    S2C_ERROR_POLYGON_INVALID_LOOP_NESTING = 206,
+    S2C_ERROR_INVALID_DIMENSION = 300,
+    S2C_ERROR_SPLIT_INTERIOR = 301,
+    S2C_ERROR_OVERLAPPING_GEOMETRY = 302,
+    S2C_ERROR_BUILDER_SNAP_RADIUS_TOO_SMALL = 500,
+    S2C_ERROR_BUILDER_MISSING_EXPECTED_SIBLING_EDGES = 501,
+    S2C_ERROR_BUILDER_UNEXPECTED_DEGENERATE_EDGE = 502,
+    S2C_ERROR_BUILDER_EDGES_DO_NOT_FORM_LOOPS = 503,
+    S2C_ERROR_BUILDER_EDGES_DO_NOT_FORM_POLYLINE = 504,
+    S2C_ERROR_BUILDER_IS_FULL_PREDICATE_NOT_SPECIFIED = 505,
+    S2C_ERROR_UNKNOWN = 1000,
+    S2C_ERROR_UNIMPLEMENTED = 1001,
+    S2C_ERROR_OUT_OF_RANGE = 1002,
+    S2C_ERROR_INVALID_ARGUMENT = 1003,
+    S2C_ERROR_FAILED_PRECONDITION = 1004,
+    S2C_ERROR_INTERNAL = 1005,
+    S2C_ERROR_DATA_LOSS = 1006,
+    S2C_ERROR_RESOURCE_EXHAUSTED = 1007,
+    S2C_ERROR_CANCELLED = 1008
+} S2CErrorCode;
+
+// text is malloc'd only when ok is false; successful calls leave it NULL.
+// code (an S2CErrorCode) was added in 2.0, which changed the size of this
+// caller-allocated struct: code built against 1.x must be recompiled.
 typedef struct S2CError {
     bool ok;
     char* text;
+    int code;
 } S2CError;
 
 // Opaque pointer types
@@ -34,6 +75,10 @@ typedef struct S2CPolygonLayer S2CPolygonLayer;
 typedef struct S2CBooleanOperation S2CBooleanOperation;
 typedef struct S2CBufferOperation S2CBufferOperation;
 typedef struct S2CMutableShapeIndex S2CMutableShapeIndex;
+typedef struct S2CThreadPool S2CThreadPool;
+typedef struct S2CCancelToken S2CCancelToken;
+typedef struct S2CMemoryTracker S2CMemoryTracker;
+typedef struct S2CGenerator S2CGenerator;
 typedef struct S1CAngle S1CAngle;
 typedef struct S1CChordAngle S1CChordAngle;
 typedef struct S1CInterval S1CInterval;
@@ -132,6 +177,50 @@ void s2c_cellid_to_face_ij_orientation(const S2CCellId* cellid, int* pface, int*
 void s2c_cellid_append_all_neighbors(const S2CCellId* cellid, int nbr_level, S2CCellId*** neighbors, int* count);
 void s2c_cellid_append_vertex_neighbors(const S2CCellId* cellid, int level, S2CCellId*** neighbors, int* count);
 
+// S2CellId array kernels over raw uint64 ids. Inputs must be valid cell ids
+// (and for parent, at or below `level`); out may alias the input.
+void s2c_cellid_parent_batch(const uint64_t* ids, size_t n, int level, uint64_t* out);
+void s2c_cellid_child_begin_batch(const uint64_t* ids, size_t n, int level, uint64_t* out);
+void s2c_cellid_child_end_batch(const uint64_t* ids, size_t n, int level, uint64_t* out);
+void s2c_cellid_range_min_batch(const uint64_t* ids, size_t n, uint64_t* out);
+void s2c_cellid_range_max_batch(const uint64_t* ids, size_t n, uint64_t* out);
+void s2c_cellid_contains_batch(const uint64_t* a, const uint64_t* b, size_t n, uint8_t* out);
+void s2c_cellid_level_batch(const uint64_t* ids, size_t n, uint8_t* out);
+void s2c_cellid_face_batch(const uint64_t* ids, size_t n, uint8_t* out);
+
+// Neighbor enumeration into caller buffers. The *_ids functions write up to
+// capacity ids and return the total number of neighbors, so a short buffer
+// can be resized and the call repeated. edge_neighbor_ids always fills all
+// four slots, with 0 (S2CellId::None()) for an invalid id.
+void s2c_cellid_edge_neighbor_ids(uint64_t id, uint64_t neighbors[4]);
+int s2c_cellid_all_neighbor_ids(uint64_t id, int nbr_level, uint64_t* out, int capacity);
+int s2c_cellid_vertex_neighbor_ids(uint64_t id, int level, uint64_t* out, int capacity);
+// Cells within k neighbor steps of each input cell (including itself), sorted
+// and deduplicated per input; ring i spans [(*out_offsets)[i], (*out_offsets)[i + 1]).
+// Free both outputs with s2c_free_buffer.
+int64_t s2c_cellid_k_ring_batch(const uint64_t* ids, size_t n, int k, int num_threads,
+                                uint64_t** out_ids, int64_t** out_offsets);
+
+// Batch token conversion. Packed buffers hold tokens back to back with
+// offsets[n + 1] (bytes needs room for 16 * n chars); fixed-stride buffers hold
+// one NUL-padded token every stride (>= 16) bytes. Decoding returns the number
+// of valid tokens; invalid ones decode to 0. num_threads caps the threads taken
+// from the shared pool (<= 0 for all).
+int64_t s2c_cellid_to_tokens_packed(const uint64_t* ids, size_t n, char* bytes, int64_t* offsets, int num_threads);
+bool s2c_cellid_to_tokens_fixed(const uint64_t* ids, size_t n, char* out, size_t stride, int num_threads);
+size_t s2c_cellid_from_tokens_packed(const char* bytes, const int64_t* offsets, size_t n, uint64_t* out,
+                                     int num_threads);
+size_t s2c_cellid_from_tokens_fixed(const char* tokens, size_t n, size_t stride, uint64_t* out, int num_threads);
+
+// S2CellId (Hilbert curve) ordering of flat xyz point batches. permutation_out[i]
+// is the index of the i-th point in leaf cell id order (ties keep input order).
+bool s2c_sort_points_by_cellid(const double* xyz, size_t n, uint32_t* permutation_out);
+// Sorts as above and splits the order into num_parts balanced, spatially compact
+// parts: part p is permutation_out[part_offsets[p] .. part_offsets[p + 1]).
+// part_ranges (optional, 2 * num_parts) receives each part's first and last leaf id.
+bool s2c_partition_points_by_cellid(const double* xyz, size_t n, int num_parts, uint32_t* permutation_out,
+                                    size_t* part_offsets, uint64_t* part_ranges);
+
 // S1Angle functions
 S1CAngle* s1c_angle_new(void);
 S1CAngle* s1c_angle_from_radians(double radians);
@@ -272,6 +361,8 @@ S2CCap* s2c_loop_get_cap_bound(const S2CLoop* loop);
 S2CLatLngRect* s2c_loop_get_rect_bound(const S2CLoop* loop);
 bool s2c_loop_may_intersect_cell(const S2CLoop* loop, const S2CCell* cell);
 S2CLoop* s2c_loop_clone(const S2CLoop* loop);
+// S2's encoding in a buffer freed with s2c_free_buffer. Decode replaces the
+// loop and leaves it unchanged if data is not a valid encoding.
 char* s2c_loop_encode(const S2CLoop* loop, size_t* length);
 bool s2c_loop_decode(S2CLoop* loop, const char* data, size_t length);
 
@@ -300,9 +391,56 @@ bool s2c_polyline_may_intersect_cell(const S2CPolyline* polyline, const S2CCell*
 S2CCap* s2c_polyline_get_cap_bound(const S2CPolyline* polyline);
 S2CLatLngRect* s2c_polyline_get_rect_bound(const S2CPolyline* polyline);
 S2CPolyline* s2c_polyline_clone(const S2CPolyline* polyline);
+// Same conventions as s2c_loop_encode/decode
 char* s2c_polyline_encode(const S2CPolyline* polyline, size_t* length);
 bool s2c_polyline_decode(S2CPolyline* polyline, const char* data, size_t length);
 
+// Polyline simplification on flat xyz buffers. Each output holds at most as
+// many vertices as its input, so output buffers may be sized like the input.
+// Batch variants process polyline i = vertices [offsets[i], offsets[i + 1]).
+int s2c_polyline_subsample_vertices(const S2CPolyline* polyline, const S1CAngle* tolerance, int* indices);
+int s2c_polyline_subsample_vertices_xyz(const double* xyz, int num_vertices, double tolerance_radians, int* indices);
+int s2c_polyline_simplify_xyz(const double* xyz, int num_vertices, double tolerance_radians, double* out_xyz);
+int s2c_polylines_subsample_batch(const double* xyz, const int* offsets, int num_polylines,
+                                  double tolerance_radians, int* out_indices, int* out_offsets);
+int s2c_polylines_simplify_batch(const double* xyz, const int* offsets, int num_polylines,
+                                 double tolerance_radians, double* out_xyz, int* out_offsets);
+
+// S2PolylineAlignment functions (dynamic time warping on flat xyz buffers).
+// warp_path receives (a_index, b_index) pairs and needs room for
+// 2 * (num_a + num_b) ints. A radius < 0 uses the library default.
+double s2c_polyline_exact_vertex_alignment_cost(const double* a_xyz, int num_a, const double* b_xyz, int num_b);
+double s2c_polyline_exact_vertex_alignment(const double* a_xyz, int num_a, const double* b_xyz, int num_b,
+                                           int* warp_path, int* path_length);
+double s2c_polyline_approx_vertex_alignment(const double* a_xyz, int num_a, const double* b_xyz, int num_b,
+                                            int radius, int* warp_path, int* path_length);
+// The multi-polyline functions need every polyline to have at least one
+// vertex; otherwise medoid returns -1, consensus 0 and the cost matrix false.
+int s2c_polyline_medoid(const double* xyz, const int* offsets, int num_polylines, bool approx);
+int s2c_polyline_consensus(const double* xyz, const int* offsets, int num_polylines, bool approx,
+                           bool seed_medoid, int iteration_cap, double** out_xyz);
+// Fills the symmetric num_polylines x num_polylines row-major cost matrix,
+// computing pairs on up to num_threads threads of the shared pool (<= 0 for all).
+bool s2c_polyline_alignment_cost_matrix(const double* xyz, const int* offsets, int num_polylines,
+                                        bool approx, int num_threads, double* costs);
+
+// S2EdgeTessellator functions (planar coordinates are flat (x, y) pairs)
+typedef enum {
+    S2C_PROJECTION_PLATE_CARREE,
+    S2C_PROJECTION_MERCATOR
+} S2CProjectionType;
+
+typedef struct S2CEdgeTessellator S2CEdgeTessellator;
+// scale is the x range half-width, e.g. 180 for degrees
+S2CEdgeTessellator* s2c_edge_tessellator_new(S2CProjectionType projection, double scale, double tolerance_radians);
+void s2c_edge_tessellator_destroy(S2CEdgeTessellator* tessellator);
+int s2c_edge_tessellator_project(const S2CEdgeTessellator* tessellator, const double* xyz, int num_vertices, double** out_xy);
+int s2c_edge_tessellator_unproject(const S2CEdgeTessellator* tessellator, const double* xy, int num_vertices, double** out_xyz);
+int s2c_edge_tessellator_project_batch(const S2CEdgeTessellator* tessellator, const double* xyz, const int* offsets,
+                                       int num_polylines, double** out_xy, int** out_offsets);
+int s2c_edge_tessellator_unproject_batch(const S2CEdgeTessellator* tessellator, const double* xy, const int* offsets,
+                                         int num_polylines, double** out_xyz, int** out_offsets);
+
 // S2Polygon functions
 S2CPolygon* s2c_polygon_new(void);
 S2CPolygon* s2c_polygon_new_from_loop(S2CLoop* loop);
@@ -311,6 +449,11 @@ void s2c_polygon_destroy(S2CPolygon* polygon);
 void s2c_polygon_init(S2CPolygon* polygon, S2CLoop* loop);
 void s2c_polygon_init_nested(S2CPolygon* polygon, S2CLoop** loops, int num_loops);
 void s2c_polygon_init_to_union(S2CPolygon* polygon, S2CPolygon** polygons, int num_polygons);
+void s2c_polygon_init_to_intersection(S2CPolygon* polygon, const S2CPolygon* a, const S2CPolygon* b);
+// Intersects each polygon with clip into a new polygon (NULL for NULL inputs)
+// and returns the number of polygons written. pool may be NULL.
+int s2c_polygon_intersection_batch(const S2CPolygon* clip, S2CPolygon** polygons, int num_polygons,
+                                   S2CThreadPool* pool, S2CPolygon** out);
 void s2c_polygon_copy(S2CPolygon* dest, const S2CPolygon* src);
 int s2c_polygon_num_loops(const S2CPolygon* polygon);
 S2CLoop* s2c_polygon_loop(const S2CPolygon* polygon, int i);
@@ -333,6 +476,7 @@ bool s2c_polygon_may_intersect_cell(const S2CPolygon* polygon, const S2CCell* ce
 S2CCap* s2c_polygon_get_cap_bound(const S2CPolygon* polygon);
 S2CLatLngRect* s2c_polygon_get_rect_bound(const S2CPolygon* polygon);
 S2CPolygon* s2c_polygon_clone(const S2CPolygon* polygon);
+// Same conventions as s2c_loop_encode/decode
 char* s2c_polygon_encode(const S2CPolygon* polygon, size_t* length);
 bool s2c_polygon_decode(S2CPolygon* polygon, const char* data, size_t length);
 
@@ -382,15 +526,19 @@ S2CCellUnion* s2c_cellunion_new(void);
 S2CCellUnion* s2c_cellunion_new_from_ids(const uint64_t* cell_ids, int num_cells);
 S2CCellUnion* s2c_cellunion_new_from_cellids(const S2CCellId** cellids, int num_cells);
 S2CCellUnion* s2c_cellunion_from_normalized(const S2CCellId** cellids, int num_cells);
+// Takes ownership of a malloc'd id array, normalizing it in place
+S2CCellUnion* s2c_cellunion_new_from_ids_take(uint64_t* cell_ids, int num_cells);
 void s2c_cellunion_destroy(S2CCellUnion* cell_union);
 void s2c_cellunion_init(S2CCellUnion* cell_union, const uint64_t* cell_ids, int num_cells);
 int s2c_cellunion_num_cells(const S2CCellUnion* cell_union);
 S2CCellId* s2c_cellunion_cell_id(const S2CCellUnion* cell_union, int i);
-uint64_t* s2c_cellunion_cell_ids(const S2CCellUnion* cell_union, int* num_cells);
+// Borrowed view of the union's sorted ids; valid until the union is modified or destroyed
+const uint64_t* s2c_cellunion_cell_ids(const S2CCellUnion* cell_union, int* num_cells);
 bool s2c_cellunion_empty(const S2CCellUnion* cell_union);
 bool s2c_cellunion_is_normalized(const S2CCellUnion* cell_union);
 void s2c_cellunion_normalize(S2CCellUnion* cell_union);
-void s2c_cellunion_normalize_in_place(S2CCellId** cellids, int* num_cells);
+// Normalizes a plain id array in place and returns the new length
+int s2c_cellunion_normalize_in_place(uint64_t* cell_ids, int num_cells);
 void s2c_cellunion_denormalize(const S2CCellUnion* cell_union, int min_level, int level_mod, S2CCellId*** output, int* count);
 double s2c_cellunion_exact_area(const S2CCellUnion* cell_union);
 double s2c_cellunion_approx_area(const S2CCellUnion* cell_union);
@@ -401,6 +549,20 @@ bool s2c_cellunion_intersects(const S2CCellUnion* a, const S2CCellUnion* b);
 bool s2c_cellunion_intersects_cellid(const S2CCellUnion* cell_union, const S2CCellId* cellid);
 S2CCellUnion* s2c_cellunion_intersection(const S2CCellUnion* a, const S2CCellUnion* b);
 S2CCellUnion* s2c_cellunion_get_difference(const S2CCellUnion* a, const S2CCellUnion* b);
+S2CCellUnion* s2c_cellunion_union(const S2CCellUnion* a, const S2CCellUnion* b);
+// Set operations writing into a reusable union (out may alias a or b)
+void s2c_cellunion_union_into(const S2CCellUnion* a, const S2CCellUnion* b, S2CCellUnion* out);
+void s2c_cellunion_intersection_into(const S2CCellUnion* a, const S2CCellUnion* b, S2CCellUnion* out);
+void s2c_cellunion_difference_into(const S2CCellUnion* a, const S2CCellUnion* b, S2CCellUnion* out);
+// Sets out[i] to whether ids[i] is contained; fastest when ids are sorted. Returns the number contained.
+int s2c_cellunion_contains_ids(const S2CCellUnion* cell_union, const uint64_t* ids, int n, uint8_t* out);
+void s2c_cellunion_expand_level(S2CCellUnion* cell_union, int level);
+void s2c_cellunion_expand_radius(S2CCellUnion* cell_union, double min_radius_radians, int max_level_diff);
+S2CCellUnion* s2c_cellunion_from_min_max(uint64_t min_id, uint64_t max_id);
+S2CCellUnion* s2c_cellunion_from_begin_end(uint64_t begin, uint64_t end);
+bool s2c_cellunion_init_from_min_max(S2CCellUnion* cell_union, uint64_t min_id, uint64_t max_id);
+bool s2c_cellunion_init_from_begin_end(S2CCellUnion* cell_union, uint64_t begin, uint64_t end);
+uint64_t s2c_cellunion_leaf_cells_covered(const S2CCellUnion* cell_union);
 bool s2c_cellunion_may_intersect_cell(const S2CCellUnion* cell_union, const S2CCell* cell);
 S2CCap* s2c_cellunion_get_cap_bound(const S2CCellUnion* cell_union);
 S2CLatLngRect* s2c_cellunion_get_rect_bound(const S2CCellUnion* cell_union);
@@ -408,6 +570,19 @@ S2CCellUnion* s2c_cellunion_clone(const S2CCellUnion* cell_union);
 char* s2c_cellunion_encode(const S2CCellUnion* cell_union, size_t* length);
 bool s2c_cellunion_decode(S2CCellUnion* cell_union, const char* data, size_t length);
 
+// Region reference for batch APIs; region points at the S2C handle of the given type
+typedef enum {
+    S2C_REGION_CAP,
+    S2C_REGION_RECT,
+    S2C_REGION_CELL,
+    S2C_REGION_POLYGON
+} S2CRegionType;
+
+typedef struct {
+    S2CRegionType type;
+    const void* region;
+} S2CRegionRef;
+
 // S2RegionCoverer functions
 S2CRegionCoverer* s2c_regioncoverer_new(void);
 void s2c_regioncoverer_destroy(S2CRegionCoverer* coverer);
@@ -430,6 +605,43 @@ void s2c_regioncoverer_get_interior_covering_rect(S2CRegionCoverer* coverer, con
 void s2c_regioncoverer_get_interior_covering_cell(S2CRegionCoverer* coverer, const S2CCell* cell, S2CCellId*** interior, int* count);
 void s2c_regioncoverer_get_interior_covering_polygon(S2CRegionCoverer* coverer, const S2CPolygon* polygon, S2CCellId*** interior, int* count);
 
+// Batch covering of mixed regions. Returns the total number of cell ids;
+// *out_ids holds all coverings concatenated and region i spans
+// [(*out_offsets)[i], (*out_offsets)[i + 1]). Free both with s2c_free_buffer.
+// Work runs on up to num_threads threads of the shared pool (<= 0 for all).
+int64_t s2c_regioncoverer_get_coverings_batch(const S2CRegionCoverer* coverer, const S2CRegionRef* regions,
+                                              int num_regions, bool interior, int num_threads,
+                                              uint64_t** out_ids, int64_t** out_offsets);
+// Fixed-level coverings: every level `level` cell that may intersect the
+// region, sorted. Matches GetCovering with set_fixed_level but skips the
+// general coverer. Returns the cell count; free *out_ids with s2c_free_buffer.
+int64_t s2c_regioncoverer_fixed_level_covering_cap(const S2CCap* cap, int level, uint64_t** out_ids);
+int64_t s2c_regioncoverer_fixed_level_covering_rect(const S2CLatLngRect* rect, int level, uint64_t** out_ids);
+// Coverings of every shape in an index, optionally expanded by a radius
+// (no buffer polygon is built). Free *out_ids with s2c_free_buffer.
+int64_t s2c_regioncoverer_get_covering_shape_index(S2CRegionCoverer* coverer, const S2CMutableShapeIndex* index,
+                                                   bool interior, uint64_t** out_ids);
+int64_t s2c_regioncoverer_get_covering_buffered_shape_index(S2CRegionCoverer* coverer,
+                                                            const S2CMutableShapeIndex* index,
+                                                            double radius_radians, uint64_t** out_ids);
+
+// S2CoveringCache functions (bounded LRU of coverings, safe to share across threads).
+// Returned coverings are read-only and stay valid after eviction until
+// s2c_covering_destroy.
+typedef struct S2CCoveringCache S2CCoveringCache;
+typedef struct S2CCovering S2CCovering;
+S2CCoveringCache* s2c_covering_cache_new(size_t max_entries);
+void s2c_covering_cache_destroy(S2CCoveringCache* cache);
+S2CCovering* s2c_covering_cache_get(S2CCoveringCache* cache, const S2CRegionCoverer* coverer,
+                                    const S2CRegionRef* region, bool interior);
+void s2c_covering_cache_clear(S2CCoveringCache* cache);
+size_t s2c_covering_cache_size(S2CCoveringCache* cache);
+uint64_t s2c_covering_cache_hits(S2CCoveringCache* cache);
+uint64_t s2c_covering_cache_misses(S2CCoveringCache* cache);
+const uint64_t* s2c_covering_ids(const S2CCovering* covering);
+int64_t s2c_covering_size(const S2CCovering* covering);
+void s2c_covering_destroy(S2CCovering* covering);
+
 // S2RegionTermIndexer functions
 S2CRegionTermIndexer* s2c_regiontermindexer_new(void);
 void s2c_regiontermindexer_destroy(S2CRegionTermIndexer* indexer);
@@ -465,7 +677,13 @@ S2CBuilder* s2c_builder_new(void);
 void s2c_builder_destroy(S2CBuilder* builder);
 void s2c_builder_start_layer(S2CBuilder* builder, S2CBuilderLayer* layer);
 void s2c_builder_add_edge(S2CBuilder* builder, const S2CPoint* v0, const S2CPoint* v1);
+// Bulk input: xyz holds 3 doubles per vertex, chain i spans vertices
+// [chain_offsets[i], chain_offsets[i + 1]).
+void s2c_builder_add_edges(S2CBuilder* builder, const double* xyz, const int* chain_offsets, int num_chains);
+void s2c_builder_add_loops(S2CBuilder* builder, const double* xyz, const int* loop_offsets, int num_loops);
 bool s2c_builder_build(S2CBuilder* builder, S2CError* error);
+bool s2c_builder_build_cancellable(S2CBuilder* builder, const S2CCancelToken* token, S2CError* error);
+void s2c_builder_set_memory_tracker(S2CBuilder* builder, S2CMemoryTracker* tracker);
 
 // S2BuilderLayer (base for layers)
 void s2c_builder_layer_destroy(S2CBuilderLayer* layer);
@@ -475,9 +693,49 @@ S2CPolygonLayer* s2c_polygon_layer_new(S2CPolygon* polygon);
 S2CPolygonLayer* s2c_polygon_layer_new_with_options(S2CPolygon* polygon, S2CEdgeType edge_type);
 S2CBuilderLayer* s2c_polygon_layer_as_builder_layer(S2CPolygonLayer* layer);
 
+// S2GraphLayer: streams the built S2Builder::Graph to a callback. Edges are
+// (v0, v1) vertex index pairs; the input edge ids of edge e are
+// input_edge_ids[input_edge_offsets[e] .. input_edge_offsets[e + 1]).
+// All buffers are owned by the layer and valid only during the callback.
+// Returning false from the callback fails the build.
+typedef enum {
+    S2C_DEGENERATE_EDGES_DISCARD,
+    S2C_DEGENERATE_EDGES_DISCARD_EXCESS,
+    S2C_DEGENERATE_EDGES_KEEP
+} S2CDegenerateEdges;
+
+typedef enum {
+    S2C_DUPLICATE_EDGES_MERGE,
+    S2C_DUPLICATE_EDGES_KEEP
+} S2CDuplicateEdges;
+
+typedef enum {
+    S2C_SIBLING_PAIRS_DISCARD,
+    S2C_SIBLING_PAIRS_DISCARD_EXCESS,
+    S2C_SIBLING_PAIRS_KEEP,
+    S2C_SIBLING_PAIRS_REQUIRE,
+    S2C_SIBLING_PAIRS_CREATE
+} S2CSiblingPairs;
+
+typedef bool (*S2CGraphCallback)(const double* vertices, int num_vertices,
+                                 const int32_t* edges, int num_edges,
+                                 const int32_t* input_edge_offsets, const int32_t* input_edge_ids,
+                                 void* user_data);
+
+typedef struct S2CGraphLayer S2CGraphLayer;
+S2CGraphLayer* s2c_graph_layer_new(S2CGraphCallback callback, void* user_data);
+S2CGraphLayer* s2c_graph_layer_new_with_options(S2CGraphCallback callback, void* user_data,
+                                                S2CEdgeType edge_type,
+                                                S2CDegenerateEdges degenerate_edges,
+                                                S2CDuplicateEdges duplicate_edges,
+                                                S2CSiblingPairs sibling_pairs);
+void s2c_graph_layer_destroy(S2CGraphLayer* layer);
+S2CBuilderLayer* s2c_graph_layer_as_builder_layer(S2CGraphLayer* layer);
+
 // S2BooleanOperation functions
 S2CBooleanOperation* s2c_boolean_operation_new(S2CBooleanOpType op_type, S2CBuilderLayer* layer);
 void s2c_boolean_operation_destroy(S2CBooleanOperation* op);
+void s2c_boolean_operation_set_memory_tracker(S2CBooleanOperation* op, S2CMemoryTracker* tracker);
 bool s2c_boolean_operation_build(S2CBooleanOperation* op, S2CError* error);
 
 // Forward declarations for shape index types (defined later)
@@ -514,6 +772,43 @@ void s2c_buffer_operation_destroy(S2CBufferOperation* op);
 void s2c_buffer_operation_add_polygon(S2CBufferOperation* op, S2CPolygon* polygon);
 void s2c_buffer_operation_add_point(S2CBufferOperation* op, const S2CPoint* point);
 bool s2c_buffer_operation_build(S2CBufferOperation* op, S2CError* error);
+bool s2c_buffer_operation_build_cancellable(S2CBufferOperation* op, const S2CCancelToken* token, S2CError* error);
+void s2c_buffer_operation_set_memory_tracker(S2CBufferOperation* op, S2CMemoryTracker* tracker);
+
+// S2WindingOperation functions
+typedef enum {
+    S2C_WINDING_RULE_POSITIVE,
+    S2C_WINDING_RULE_NEGATIVE,
+    S2C_WINDING_RULE_NON_ZERO,
+    S2C_WINDING_RULE_ODD
+} S2CWindingRule;
+
+typedef struct S2CWindingOperation S2CWindingOperation;
+S2CWindingOperation* s2c_winding_operation_new(S2CBuilderLayer* layer);
+S2CWindingOperation* s2c_winding_operation_new_with_snap_level(S2CBuilderLayer* layer, int snap_level);
+void s2c_winding_operation_destroy(S2CWindingOperation* op);
+void s2c_winding_operation_add_loop(S2CWindingOperation* op, const S2CLoop* loop);
+void s2c_winding_operation_add_loops(S2CWindingOperation* op, const double* xyz, const int* loop_offsets, int num_loops);
+// ref_point may be NULL to use S2::Origin() with winding number ref_winding.
+bool s2c_winding_operation_build(S2CWindingOperation* op, const S2CPoint* ref_point, int ref_winding,
+                                 S2CWindingRule rule, S2CError* error);
+
+// S2ConvexHullQuery functions
+typedef struct S2CConvexHullQuery S2CConvexHullQuery;
+S2CConvexHullQuery* s2c_convex_hull_query_new(void);
+void s2c_convex_hull_query_destroy(S2CConvexHullQuery* query);
+void s2c_convex_hull_query_add_point(S2CConvexHullQuery* query, const S2CPoint* point);
+void s2c_convex_hull_query_add_points(S2CConvexHullQuery* query, const double* xyz, size_t num_points);
+void s2c_convex_hull_query_add_polyline(S2CConvexHullQuery* query, const S2CPolyline* polyline);
+void s2c_convex_hull_query_add_loop(S2CConvexHullQuery* query, const S2CLoop* loop);
+void s2c_convex_hull_query_add_polygon(S2CConvexHullQuery* query, const S2CPolygon* polygon);
+S2CCap* s2c_convex_hull_query_get_cap_bound(S2CConvexHullQuery* query);
+S2CLoop* s2c_convex_hull_query_get_convex_hull(S2CConvexHullQuery* query);
+// Computes one hull per run of equal group ids (points must be grouped/sorted
+// by group id). Returns the number of hulls; free with s2c_free_loop_array
+// and s2c_free_buffer.
+int s2c_convex_hull_batch(const double* xyz, const int64_t* group_ids, size_t num_points,
+                          S2CLoop*** hulls, int64_t** hull_group_ids);
 
 // S2ShapeIndex functions (immutable index)
 typedef struct S2CShapeIndex S2CShapeIndex;
@@ -533,8 +828,20 @@ void s2c_mutable_shape_index_add_loop(S2CMutableShapeIndex* index, S2CLoop* loop
 int s2c_mutable_shape_index_num_shape_ids(const S2CMutableShapeIndex* index);
 int s2c_mutable_shape_index_num_edges(const S2CMutableShapeIndex* index);
 void s2c_mutable_shape_index_minimize(S2CMutableShapeIndex* index);
+// With a memory tracker attached, a build that runs out of budget sets
+// s2c_last_error_code to S2C_ERROR_RESOURCE_EXHAUSTED and leaves the index
+// unusable. Queries build lazily and cannot report such a failure (the next
+// add, minimize or build on the index does), so force the build before
+// querying a tracked index.
 void s2c_mutable_shape_index_force_build(S2CMutableShapeIndex* index);
+// S2 abandons a cancelled build; destroy the index rather than query it
+bool s2c_mutable_shape_index_force_build_cancellable(S2CMutableShapeIndex* index, const S2CCancelToken* token,
+                                                     S2CError* error);
 S2CShapeIndex* s2c_mutable_shape_index_snapshot(const S2CMutableShapeIndex* index);
+// Attaching charges the index's current size to tracker; NULL detaches. Adds,
+// minimize and builds keep the charge up to date.
+void s2c_mutable_shape_index_set_memory_tracker(S2CMutableShapeIndex* index, S2CMemoryTracker* tracker);
+int64_t s2c_mutable_shape_index_space_used(const S2CMutableShapeIndex* index);
 
 // S2ContainsPointQuery for fast point-in-polygon tests
 typedef struct S2CContainsPointQuery S2CContainsPointQuery;
@@ -586,9 +893,99 @@ int s2c_crossing_edge_pair_edge_id(const S2CCrossingEdgePair* pair);
 S2CPoint* s2c_crossing_edge_pair_a(const S2CCrossingEdgePair* pair);
 S2CPoint* s2c_crossing_edge_pair_b(const S2CCrossingEdgePair* pair);
 
+// Frozen indexes and per-thread queries
+// A query object must only be used by one thread at a time. A frozen index is
+// fully built and rejects further adds and minimize, so any number of threads
+// may query it concurrently without locking. The thread-local getters return a
+// query owned by the calling thread (NULL unless the index is frozen); do not
+// destroy it. Options set on it persist for later calls on the same thread.
+void s2c_mutable_shape_index_freeze(S2CMutableShapeIndex* index);
+bool s2c_mutable_shape_index_is_frozen(const S2CMutableShapeIndex* index);
+S2CContainsPointQuery* s2c_index_thread_local_contains_query(const S2CMutableShapeIndex* index);
+S2CClosestEdgeQuery* s2c_index_thread_local_closest_edge_query(const S2CMutableShapeIndex* index);
+S2CCrossingEdgeQuery* s2c_index_thread_local_crossing_edge_query(const S2CMutableShapeIndex* index);
+// Frees the calling thread's queries for index. Optional: other threads drop
+// queries for destroyed indexes on their next thread-local lookup.
+void s2c_index_thread_local_release(const S2CMutableShapeIndex* index);
+
+// S2CThreadPool functions
+// Worker pool for batch operations. Functions taking a pool run on it (NULL
+// for the library-owned shared pool); functions taking num_threads run on
+// the shared pool with at most that many threads (<= 0 for all of them).
+// The calling thread always takes part, so batch calls may be nested.
+S2CThreadPool* s2c_thread_pool_new(int num_threads, bool pin_threads);
+// Finishes queued work before returning; the shared pool is never destroyed
+void s2c_thread_pool_destroy(S2CThreadPool* pool);
+int s2c_thread_pool_num_threads(const S2CThreadPool* pool);
+S2CThreadPool* s2c_thread_pool_default(void);
+
+// Batch point queries over n points in a flat xyz buffer, scheduled in
+// S2CellId order so each thread walks nearby index cells. Results are in
+// input order. Points with no closest edge get shape and edge id -1 and
+// distance -1; edge_ids and distances may be NULL.
+bool s2c_contains_point_query_batch(const S2CMutableShapeIndex* index, const double* xyz, size_t n,
+                                    S2CThreadPool* pool, uint8_t* out);
+bool s2c_closest_edge_query_batch(const S2CMutableShapeIndex* index, const double* xyz, size_t n,
+                                  S2CThreadPool* pool, int32_t* shape_ids, int32_t* edge_ids,
+                                  double* distances);
+
+// Asynchronous batch operations
+// Each *_async call queues the work on pool (NULL for the shared pool) and
+// returns at once. Inputs and outputs must stay valid until the task
+// finishes. The callback, if any, runs on a pool thread once the task is
+// DONE or CANCELLED. Cancelling a running task stops it at the next chunk
+// boundary; outputs of a cancelled task are unspecified, except that
+// buffers and polygons which were allocated are still the caller's to free.
+// Callbacks must not wait on other tasks: on a busy pool there may be no
+// thread left to run them.
+typedef struct S2CTask S2CTask;
+typedef enum {
+    S2C_TASK_PENDING,
+    S2C_TASK_RUNNING,
+    S2C_TASK_DONE,
+    S2C_TASK_CANCELLED
+} S2CTaskStatus;
+typedef void (*S2CTaskCallback)(S2CTask* task, S2CTaskStatus status, void* user_data);
+
+S2CTaskStatus s2c_task_poll(const S2CTask* task);
+// Waits up to timeout_ms (< 0 waits indefinitely) and returns the status
+S2CTaskStatus s2c_task_wait(S2CTask* task, int64_t timeout_ms);
+// Returns true if the task had not finished yet
+bool s2c_task_cancel(S2CTask* task);
+// The operation's count once DONE: shapes indexed, cell ids, points
+// contained or polygons written
+int64_t s2c_task_result(const S2CTask* task);
+// Cancels an unfinished task. A task that has not started is dropped at once
+// and its callback never runs; a started one is waited for, callback
+// included. May be called from the task's own callback.
+void s2c_task_destroy(S2CTask* task);
+
+// A build that runs out of the index's memory budget is still DONE, with
+// -S2C_ERROR_RESOURCE_EXHAUSTED as its result instead of the shape count
+S2CTask* s2c_mutable_shape_index_force_build_async(S2CMutableShapeIndex* index, S2CThreadPool* pool,
+                                                   S2CTaskCallback callback, void* user_data);
+S2CTask* s2c_regioncoverer_get_coverings_batch_async(const S2CRegionCoverer* coverer, const S2CRegionRef* regions,
+                                                     int num_regions, bool interior, S2CThreadPool* pool,
+                                                     uint64_t** out_ids, int64_t** out_offsets,
+                                                     S2CTaskCallback callback, void* user_data);
+S2CTask* s2c_polygon_intersection_batch_async(const S2CPolygon* clip, S2CPolygon** polygons, int num_polygons,
+                                              S2CThreadPool* pool, S2CPolygon** out,
+                                              S2CTaskCallback callback, void* user_data);
+S2CTask* s2c_contains_point_query_batch_async(const S2CMutableShapeIndex* index, const double* xyz, size_t n,
+                                              S2CThreadPool* pool, uint8_t* out,
+                                              S2CTaskCallback callback, void* user_data);
+
 // S2BooleanOperation with shape indexes (now that shape indexes are defined)
 bool s2c_boolean_operation_build_indexes(S2CBooleanOperation* op, const S2CShapeIndex* a, const S2CShapeIndex* b, S2CError* error);
 bool s2c_boolean_operation_build_mutable_indexes(S2CBooleanOperation* op, const S2CMutableShapeIndex* a, const S2CMutableShapeIndex* b, S2CError* error);
+bool s2c_boolean_operation_build_indexes_cancellable(S2CBooleanOperation* op, const S2CShapeIndex* a, const S2CShapeIndex* b,
+                                                     const S2CCancelToken* token, S2CError* error);
+bool s2c_boolean_operation_build_mutable_indexes_cancellable(S2CBooleanOperation* op, const S2CMutableShapeIndex* a,
+                                                             const S2CMutableShapeIndex* b, const S2CCancelToken* token,
+                                                             S2CError* error);
+
+// S2WindingOperation with shape indexes: adds every chain of each polygon shape as a loop
+void s2c_winding_operation_add_mutable_index(S2CWindingOperation* op, const S2CMutableShapeIndex* index);
 
 // S2 utility functions
 S2CPoint* s2c_interpolate(double t, const S2CPoint* a, const S2CPoint* b);
@@ -644,11 +1041,138 @@ const char* s2c_error_message(const S2CError* error);
 void s2c_error_set(S2CError* error, int code, const char* message);
 void s2c_error_clear(S2CError* error);
 
+// Cancellation tokens for the *_cancellable builds. A token may be cancelled
+// or given a deadline from any thread; a build that sees it fails with
+// S2C_ERROR_CANCELLED. The token is checked before the build starts and then
+// as the operation allocates memory, so a build stuck in a phase that does not
+// allocate only stops when that phase ends.
+S2CCancelToken* s2c_cancel_token_new(void);
+void s2c_cancel_token_destroy(S2CCancelToken* token);
+void s2c_cancel_token_cancel(S2CCancelToken* token);
+// Expires the token timeout_ms from now; < 0 removes the deadline
+void s2c_cancel_token_set_deadline(S2CCancelToken* token, int64_t timeout_ms);
+bool s2c_cancel_token_is_cancelled(const S2CCancelToken* token);
+void s2c_cancel_token_reset(S2CCancelToken* token);
+
+// Memory trackers. A tracker is a byte budget shared by every index, builder,
+// boolean or buffer operation attached to it, possibly on different threads.
+// Operations report usage as they allocate (every 16 KiB or so), and one
+// that would push usage past the limit fails with
+// S2C_ERROR_RESOURCE_EXHAUSTED. Detach or destroy attached objects before
+// destroying the tracker. A limit < 0 means no limit.
+S2CMemoryTracker* s2c_memory_tracker_new(int64_t limit_bytes);
+void s2c_memory_tracker_destroy(S2CMemoryTracker* tracker);
+void s2c_memory_tracker_set_limit(S2CMemoryTracker* tracker, int64_t limit_bytes);
+int64_t s2c_memory_tracker_limit(const S2CMemoryTracker* tracker);
+int64_t s2c_memory_tracker_usage(const S2CMemoryTracker* tracker);
+int64_t s2c_memory_tracker_peak_usage(const S2CMemoryTracker* tracker);
+void s2c_memory_tracker_reset_peak_usage(S2CMemoryTracker* tracker);
+
+// Synthetic workload generators. Output depends only on the seed, the
+// settings and the sequence of generate calls, never on the thread count.
+// Geometry is placed uniformly inside a cap (the whole sphere by default) or
+// around num_clusters Gaussian cluster centers drawn from it. A generator is
+// not thread-safe. Flat outputs follow the batch conventions: xyz triples,
+// item i spans vertices [offsets[i], offsets[i + 1]). Encoded outputs hold
+// item i's S2 encoding (readable with s2c_*_decode) in bytes
+// [offsets[i], offsets[i + 1]). Each call returns the number of items
+// generated (0 on invalid arguments); free the outputs with s2c_free_buffer.
+S2CGenerator* s2c_generator_new(uint64_t seed);
+void s2c_generator_destroy(S2CGenerator* generator);
+// Restarts the sequence of generate calls from seed
+void s2c_generator_reseed(S2CGenerator* generator, uint64_t seed);
+// radius_degrees >= 180 selects the whole sphere
+void s2c_generator_set_region(S2CGenerator* generator, double lat_degrees, double lng_degrees,
+                              double radius_degrees);
+// num_clusters <= 0 places geometry uniformly; spread is the standard
+// deviation of the distance from a cluster center
+void s2c_generator_set_clustering(S2CGenerator* generator, int num_clusters, double spread_degrees);
+// Fraction in [0, 1] of loops and polygons placed on top of an earlier one.
+// The others are kept clear of earlier ones while space allows.
+void s2c_generator_set_overlap(S2CGenerator* generator, double overlap);
+
+int64_t s2c_generate_points(S2CGenerator* generator, int64_t num_points, double** out_xyz);
+// Random walks (GPS traces) with steps of about step_degrees and Gaussian
+// noise of noise_degrees added to every vertex
+int s2c_generate_polylines(S2CGenerator* generator, int num_polylines, int num_vertices,
+                           double step_degrees, double noise_degrees, double** out_xyz, int** out_offsets);
+// Counter-clockwise star-shaped loops within radius_degrees (< 90) of their
+// centers. roughness in [0, 1] adds fractal detail: 0 gives regular polygons,
+// 1 jagged coastlines.
+int s2c_generate_loops(S2CGenerator* generator, int num_loops, int num_vertices, double radius_degrees,
+                       double roughness, double** out_xyz, int** out_offsets);
+// Polygons of nesting_depth concentric loops (shell, hole, island, ...) with
+// num_vertices vertices each, oriented as for S2Polygon::InitOriented (holes
+// clockwise). Loop j spans vertices [loop_offsets[j], loop_offsets[j + 1])
+// and polygon i owns loops [polygon_offsets[i], polygon_offsets[i + 1]).
+// Inner loops shrink faster at low vertex counts so edges never cross; a
+// depth whose innermost loop would be too small to be valid returns 0.
+int s2c_generate_polygons(S2CGenerator* generator, int num_polygons, int num_vertices, int nesting_depth,
+                          double radius_degrees, double roughness, double** out_xyz,
+                          int** out_loop_offsets, int** out_polygon_offsets);
+int s2c_generate_polylines_encoded(S2CGenerator* generator, int num_polylines, int num_vertices,
+                                   double step_degrees, double noise_degrees, char** out_bytes,
+                                   int64_t** out_offsets);
+int s2c_generate_loops_encoded(S2CGenerator* generator, int num_loops, int num_vertices, double radius_degrees,
+                               double roughness, char** out_bytes, int64_t** out_offsets);
+int s2c_generate_polygons_encoded(S2CGenerator* generator, int num_polygons, int num_vertices,
+                                  int nesting_depth, double radius_degrees, double roughness,
+                                  char** out_bytes, int64_t** out_offsets);
+
+// Last error reported on the calling thread; never allocates on success
+int s2c_last_error_code(void);
+const char* s2c_last_error_message(void);
+
+// S2CArena functions. Handles created by *_arena variants live until the
+// arena is reset or destroyed and must not be passed to *_destroy. An arena
+// is not thread-safe; use one per request or thread.
+typedef struct S2CArena S2CArena;
+S2CArena* s2c_arena_new(size_t block_size);  // 0 selects a 64 KiB default
+void s2c_arena_destroy(S2CArena* arena);
+void s2c_arena_reset(S2CArena* arena);
+size_t s2c_arena_bytes_used(const S2CArena* arena);
+size_t s2c_arena_bytes_reserved(const S2CArena* arena);
+S2CPoint* s2c_point_new_arena(S2CArena* arena, double x, double y, double z);
+S2CPoint* s2c_point_from_latlng_arena(S2CArena* arena, const S2CLatLng* latlng);
+S2CPoint* s2c_point_normalize_arena(S2CArena* arena, const S2CPoint* point);
+S2CLatLng* s2c_latlng_from_degrees_arena(S2CArena* arena, double lat_degrees, double lng_degrees);
+S2CLatLng* s2c_latlng_from_radians_arena(S2CArena* arena, double lat_radians, double lng_radians);
+S2CLatLng* s2c_latlng_from_point_arena(S2CArena* arena, const S2CPoint* point);
+S2CPoint* s2c_latlng_to_point_arena(S2CArena* arena, const S2CLatLng* latlng);
+S1CAngle* s2c_latlng_get_distance_arena(S2CArena* arena, const S2CLatLng* a, const S2CLatLng* b);
+S1CAngle* s1c_angle_from_radians_arena(S2CArena* arena, double radians);
+S1CAngle* s1c_angle_from_degrees_arena(S2CArena* arena, double degrees);
+S2CCellId* s2c_cellid_new_arena(S2CArena* arena, uint64_t id);
+S2CCellId* s2c_cellid_from_latlng_arena(S2CArena* arena, const S2CLatLng* latlng);
+S2CCellId* s2c_cellid_from_point_arena(S2CArena* arena, const S2CPoint* point);
+S2CCellId* s2c_cellid_parent_arena(S2CArena* arena, const S2CCellId* cellid, int level);
+S2CLatLng* s2c_cellid_to_latlng_arena(S2CArena* arena, const S2CCellId* cellid);
+S2CPoint* s2c_cellid_to_point_arena(S2CArena* arena, const S2CCellId* cellid);
+S2CCell* s2c_cell_new_arena(S2CArena* arena, const S2CCellId* cellid);
+S2CPoint* s2c_cell_get_vertex_arena(S2CArena* arena, const S2CCell* cell, int k);
+S2CCap* s2c_cap_from_center_angle_arena(S2CArena* arena, const S2CPoint* center, const S1CAngle* angle);
+S2CLatLngRect* s2c_latlngrect_new_from_latlng_arena(S2CArena* arena, const S2CLatLng* lo, const S2CLatLng* hi);
+
+// Object pool statistics. Pools exist only when the library is built with
+// S2C_ENABLE_OBJECT_POOLS; otherwise all counts are zero.
+typedef enum {
+    S2C_POOL_POINT,
+    S2C_POOL_LATLNG,
+    S2C_POOL_CELLID,
+    S2C_POOL_CLOSEST_EDGE_RESULT,
+    S2C_POOL_CROSSING_EDGE_PAIR
+} S2CPoolType;
+
+bool s2c_object_pools_enabled(void);
+void s2c_object_pool_stats(S2CPoolType type, uint64_t* hits, uint64_t* misses);
+
 // Memory management helpers
 void s2c_free_string(char* str);
 void s2c_free_string_array(char** array, int count);
 void s2c_free_cellid_array(S2CCellId** array, int count);
 void s2c_free_polyline_array(S2CPolyline** array, int count);
+void s2c_free_loop_array(S2CLoop** array, int count);
+void s2c_free_buffer(void* buffer);
 
 // Constants
 extern const int S2C_MAX_CELL_LEVEL;
@@ -1,45 +1,318 @@
 #include "s2c.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 // S2 includes
+#include "absl/numeric/bits.h"
 #include "s2/r1interval.h"
 #include "s2/s1angle.h"
 #include "s2/s1chord_angle.h"
 #include "s2/s1interval.h"
 #include "s2/s2point.h"
+#include "s2/s2pointutil.h"
+#include "s2/s2metrics.h"
 #include "s2/s2latlng.h"
 #include "s2/s2cell_id.h"
 #include "s2/s2cell.h"
 #include "s2/s2cap.h"
 #include "s2/s2loop.h"
 #include "s2/s2polyline.h"
+#include "s2/s2polyline_simplifier.h"
+#include "s2/s2polyline_alignment.h"
+#include "s2/s2edge_tessellator.h"
+#include "s2/s2projections.h"
 #include "s2/s2polygon.h"
 #include "s2/s2latlng_rect.h"
 #include "s2/s2cell_union.h"
 #include "s2/s2region_coverer.h"
 #include "s2/s2builder.h"
+#include "s2/s2memory_tracker.h"
 #include "s2/s2builderutil_s2polygon_layer.h"
 #include "s2/s2builderutil_snap_functions.h"
 #include "s2/s2boolean_operation.h"
 #include "s2/s2buffer_operation.h"
+#include "s2/s2winding_operation.h"
+#include "s2/s2convex_hull_query.h"
 #include "s2/s2earth.h"
 #include "s2/s2edge_crossings.h"
 #include "s2/s2predicates.h"
 #include "s2/mutable_s2shape_index.h"
 #include "s2/s2shape_index.h"
+#include "s2/s2shape_index_region.h"
+#include "s2/s2shape_index_buffered_region.h"
 #include "s2/s2contains_point_query.h"
 #include "s2/s2closest_edge_query.h"
 #include "s2/s2crossing_edge_query.h"
 #include "s2/s2point_vector_shape.h"
 #include "s2/s2lax_polyline_shape.h"
 #include "s2/s2shapeutil_shape_edge_id.h"
+#include "s2/util/coding/coder.h"
+
+// Object pools (S2C_ENABLE_OBJECT_POOLS)
+// Pooled handle types route new/delete through a per-type free list. Each
+// thread keeps a private cache; when it runs dry it takes the whole global
+// list with one atomic exchange, and when it grows too large it pushes half
+// of it back with a CAS. Neither operation is exposed to ABA, so frees from
+// any thread (e.g. finalizers) stay lock-free. Pooled memory is reused, never
+// returned to the system.
+#ifdef S2C_ENABLE_OBJECT_POOLS
+namespace {
+
+struct PoolNode {
+    PoolNode* next;
+};
+
+struct PoolCounters {
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+};
+
+template <typename T>
+class ObjectPool {
+  public:
+    static void* Allocate(size_t size) {
+        static_assert(sizeof(T) >= sizeof(PoolNode), "pooled types must fit a free-list link");
+        LocalCache* cache = Local();
+        if (!cache) return ::operator new(size);
+        if (!cache->head) {
+            // The global list may hold any number of nodes; count them so the
+            // next spill knows exactly how much it has to walk
+            cache->head = global_head_.exchange(nullptr, std::memory_order_acquire);
+            cache->count = 0;
+            for (PoolNode* node = cache->head; node; node = node->next) ++cache->count;
+        }
+        if (PoolNode* node = cache->head) {
+            cache->head = node->next;
+            --cache->count;
+            cache->counters.hits.fetch_add(1, std::memory_order_relaxed);
+            return node;
+        }
+        cache->counters.misses.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    static void Free(void* p) {
+        if (!p) return;
+        auto* node = static_cast<PoolNode*>(p);
+        LocalCache* cache = Local();
+        if (!cache) {
+            // Freed from a thread-local destructor after the cache is gone
+            Publish(node, node);
+            return;
+        }
+        node->next = cache->head;
+        cache->head = node;
+        if (++cache->count >= kMaxLocal) {
+            // Keep the newest half of the cache and publish the rest
+            PoolNode* tail = cache->head;
+            for (size_t i = 1; i < kMaxLocal / 2; ++i) tail = tail->next;
+            PoolNode* spill = tail->next;
+            tail->next = nullptr;
+            PoolNode* spill_tail = spill;
+            while (spill_tail->next) spill_tail = spill_tail->next;
+            Publish(spill, spill_tail);
+            cache->count = kMaxLocal / 2;
+        }
+    }
+
+    static void Stats(uint64_t* hits, uint64_t* misses) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        uint64_t h = retired_hits_, m = retired_misses_;
+        for (const PoolCounters* counters : registry_) {
+            h += counters->hits.load(std::memory_order_relaxed);
+            m += counters->misses.load(std::memory_order_relaxed);
+        }
+        if (hits) *hits = h;
+        if (misses) *misses = m;
+    }
+
+  private:
+    static const size_t kMaxLocal = 256;
+
+    struct LocalCache {
+        PoolNode* head = nullptr;
+        size_t count = 0;
+        PoolCounters counters;
+
+        LocalCache() {
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            registry_.push_back(&counters);
+        }
+        ~LocalCache() {
+            torn_down_ = true;
+            if (head) {
+                PoolNode* tail = head;
+                while (tail->next) tail = tail->next;
+                Publish(head, tail);
+            }
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            retired_hits_ += counters.hits.load(std::memory_order_relaxed);
+            retired_misses_ += counters.misses.load(std::memory_order_relaxed);
+            registry_.erase(std::find(registry_.begin(), registry_.end(), &counters));
+        }
+    };
+
+    // Null once this thread's cache has been destroyed. torn_down_ is trivially
+    // destructible, so it stays readable during other thread-local destructors.
+    static LocalCache* Local() {
+        if (torn_down_) return nullptr;
+        thread_local LocalCache cache;
+        return &cache;
+    }
+
+    static void Publish(PoolNode* first, PoolNode* last) {
+        if (!first) return;
+        PoolNode* head = global_head_.load(std::memory_order_relaxed);
+        do {
+            last->next = head;
+        } while (!global_head_.compare_exchange_weak(head, first, std::memory_order_release,
+                                                     std::memory_order_relaxed));
+    }
+
+    static inline thread_local bool torn_down_ = false;
+    static inline std::atomic<PoolNode*> global_head_{nullptr};
+    static inline std::mutex registry_mutex_;
+    static inline std::vector<const PoolCounters*> registry_;
+    static inline uint64_t retired_hits_ = 0;
+    static inline uint64_t retired_misses_ = 0;
+};
+
+}  // namespace
+
+#define S2C_POOLED(T) \
+    static void* operator new(size_t size) { return ObjectPool<T>::Allocate(size); } \
+    static void operator delete(void* p) { ObjectPool<T>::Free(p); }
+#else
+#define S2C_POOLED(T)
+#endif
+
+// Cancellation tokens. The deadline is a steady_clock time in nanoseconds.
+struct S2CCancelToken {
+    std::atomic<bool> cancelled{false};
+    std::atomic<int64_t> deadline_ns{INT64_MAX};
+};
+
+static int64_t steady_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool cancel_token_expired(const S2CCancelToken* token) {
+    if (!token) return false;
+    if (token->cancelled.load(std::memory_order_relaxed)) return true;
+    int64_t deadline = token->deadline_ns.load(std::memory_order_relaxed);
+    return deadline != INT64_MAX && steady_now_ns() >= deadline;
+}
+
+// Shared memory budget. Usage is the sum reported by every attached
+// operation, so one budget may be shared by operations on many threads.
+struct S2CMemoryTracker {
+    std::atomic<int64_t> limit{S2MemoryTracker::kNoLimit};
+    std::atomic<int64_t> usage{0};
+    std::atomic<int64_t> peak{0};
+};
+
+// The S2MemoryTracker owned by one operation. S2 runs its periodic callback
+// every kTrackerCallbackBytes of allocation; the callback forwards usage to
+// the attached budget and fails the operation once the budget is exhausted
+// or the bound cancellation token expires.
+static const int64_t kTrackerCallbackBytes = 16 << 10;
+
+struct OperationTracker {
+    OperationTracker() {
+        tracker.set_periodic_callback(kTrackerCallbackBytes, [this] { Check(); });
+    }
+    ~OperationTracker() { Attach(nullptr); }
+    OperationTracker(const OperationTracker&) = delete;
+    OperationTracker& operator=(const OperationTracker&) = delete;
+
+    void Attach(S2CMemoryTracker* new_budget) {
+        if (budget) budget->usage.fetch_sub(reported, std::memory_order_relaxed);
+        reported = 0;
+        budget = new_budget;
+        if (!budget) tracker.set_limit(S2MemoryTracker::kNoLimit);
+        Check();
+    }
+
+    void Check() {
+        if (budget) {
+            int64_t delta = tracker.usage() - reported;
+            reported += delta;
+            int64_t total = budget->usage.fetch_add(delta, std::memory_order_relaxed) + delta;
+            int64_t peak = budget->peak.load(std::memory_order_relaxed);
+            while (total > peak && !budget->peak.compare_exchange_weak(peak, total, std::memory_order_relaxed)) {}
+            // Let S2 enforce whatever the other operations have left over
+            int64_t limit = budget->limit.load(std::memory_order_relaxed);
+            if (limit == S2MemoryTracker::kNoLimit) {
+                tracker.set_limit(limit);
+            } else {
+                tracker.set_limit(std::max<int64_t>(0, limit - (total - reported)));
+                if (total > limit && tracker.ok()) {
+                    S2Error error;
+                    error.Init(S2Error::RESOURCE_EXHAUSTED, "Memory limit of %lld bytes exceeded",
+                               static_cast<long long>(limit));
+                    tracker.SetError(error);
+                }
+            }
+        }
+        if (tracker.ok() && cancel_token_expired(token)) {
+            S2Error error;
+            error.Init(S2Error::CANCELLED, "Operation cancelled");
+            tracker.SetError(error);
+        }
+    }
+
+    S2MemoryTracker tracker;
+    const S2CCancelToken* token = nullptr;
+    S2CMemoryTracker* budget = nullptr;
+    int64_t reported = 0;  // Usage already added to budget
+};
+
+// Scope of one build: binds token, then reports the final usage when the
+// build ends and clears its error so the next build starts clean. An error
+// raised while input was being added is kept for the build to report.
+class ScopedOperation {
+  public:
+    ScopedOperation(OperationTracker* tracking, const S2CCancelToken* token) : tracking_(tracking) {
+        tracking_->token = token;
+        tracking_->Check();
+    }
+    ~ScopedOperation() {
+        tracking_->token = nullptr;
+        tracking_->Check();
+        tracking_->tracker.SetError(S2Error());
+    }
+
+  private:
+    OperationTracker* tracking_;
+};
 
 // Wrapper structures
-struct S2CPoint { S2Point point; };
-struct S2CLatLng { S2LatLng latlng; };
-struct S2CCellId { S2CellId cellid; };
+struct S2CPoint { S2Point point; S2C_POOLED(S2CPoint) };
+struct S2CLatLng { S2LatLng latlng; S2C_POOLED(S2CLatLng) };
+struct S2CCellId { S2CellId cellid; S2C_POOLED(S2CCellId) };
 struct S2CCell { S2Cell cell; };
 struct S2CCap { S2Cap cap; };
 struct S2CLoop { std::unique_ptr<S2Loop> loop; };
@@ -48,13 +321,45 @@ struct S2CPolygon { std::unique_ptr<S2Polygon> polygon; };
 struct S2CLatLngRect { S2LatLngRect rect; };
 struct S2CCellUnion { S2CellUnion cell_union; };
 struct S2CRegionCoverer { S2RegionCoverer coverer; };
-struct S2CBuilder { S2Builder builder; };
+struct S2CBuilder {
+    OperationTracker tracking;  // Declared first so it outlives the builder
+    S2Builder builder;
+};
 struct S2CBuilderLayer { std::unique_ptr<S2Builder::Layer> layer; };
 struct S2CPolygonLayer { s2builderutil::S2PolygonLayer* layer; };
-struct S2CBooleanOperation { std::unique_ptr<S2BooleanOperation> op; };
+struct S2CBooleanOperation {
+    OperationTracker tracking;
+    std::unique_ptr<S2BooleanOperation> op;
+};
 struct S2CBooleanOperationOptions { S2BooleanOperation::Options options; };
-struct S2CBufferOperation { std::unique_ptr<S2BufferOperation> op; };
-struct S2CMutableShapeIndex { MutableS2ShapeIndex index; };
+struct S2CBufferOperation {
+    OperationTracker tracking;
+    std::unique_ptr<S2BufferOperation> op;
+};
+struct S2CWindingOperation { std::unique_ptr<S2WindingOperation> op; };
+struct S2CConvexHullQuery { S2ConvexHullQuery query; };
+struct S2CEdgeTessellator {
+    std::unique_ptr<S2::Projection> projection;
+    std::unique_ptr<S2EdgeTessellator> tessellator;
+};
+struct S2CCovering { std::shared_ptr<const std::vector<uint64_t>> ids; };
+struct S2CCoveringCache {
+    using Entry = std::pair<std::string, std::shared_ptr<const std::vector<uint64_t>>>;
+    size_t max_entries;
+    std::mutex mutex;
+    std::list<Entry> lru;  // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> entries;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+struct S2CMutableShapeIndex {
+    OperationTracker tracking;  // Attached while a budget is set or a cancellable build runs
+    MutableS2ShapeIndex index;
+    // Expires on destroy, so per-thread query caches can drop their entries
+    std::shared_ptr<const bool> alive = std::make_shared<const bool>(true);
+    std::once_flag freeze_once;
+    std::atomic<bool> frozen{false};
+};
 struct S2CShapeIndex { MutableS2ShapeIndex index; };  // Use MutableS2ShapeIndex as concrete type
 struct S2CContainsPointQuery { 
     std::unique_ptr<S2ContainsPointQuery<MutableS2ShapeIndex>> query; 
@@ -69,6 +374,7 @@ struct S2CClosestEdgeResult {
     int shape_id;
     int edge_id;
     S2Point edge_point;
+    S2C_POOLED(S2CClosestEdgeResult)
 };
 struct S2CCrossingEdgeQuery {
     std::unique_ptr<S2CrossingEdgeQuery> query;
@@ -79,12 +385,41 @@ struct S2CCrossingEdgePair {
     int edge_id;
     S2Point a;
     S2Point b;
+    S2C_POOLED(S2CCrossingEdgePair)
 };
 struct S1CAngle { S1Angle angle; };
 struct S1CChordAngle { S1ChordAngle angle; };
 struct R1CInterval { R1Interval interval; };
 struct S1CInterval { S1Interval interval; };
 
+// Bump allocator for short-lived handles. Blocks are kept across resets, and
+// destructors are recorded only for types that need them.
+struct S2CArena {
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+    size_t block_size;
+    std::vector<Block> blocks;
+    size_t current = 0;  // Index of the block being filled
+    size_t offset = 0;   // Next free byte in blocks[current]
+    size_t bytes_used = 0;
+    std::vector<std::pair<void*, void (*)(void*)>> destructors;
+};
+
+// Seeded generator settings. Cluster centers are redrawn from the seed
+// whenever the region, clustering or seed changes.
+struct S2CGenerator {
+    uint64_t seed = 0;
+    uint64_t calls = 0;  // Generate calls since the last (re)seed
+    S2Point region_center{1, 0, 0};
+    double region_height = 2.0;  // S2Cap height; 2 is the whole sphere
+    int num_clusters = 0;
+    double spread_radians = 0.0;
+    double overlap = 0.0;
+    std::vector<S2Point> clusters;
+};
+
 // Constants
 const int S2C_MAX_CELL_LEVEL = S2CellId::kMaxLevel;
 
@@ -97,6 +432,330 @@ static char* copy_string(const std::string& str) {
     return result;
 }
 
+static_assert(S2C_ERROR_NOT_UNIT_LENGTH == S2Error::NOT_UNIT_LENGTH, "S2CErrorCode out of sync");
+static_assert(S2C_ERROR_LOOP_NOT_ENOUGH_VERTICES == S2Error::LOOP_NOT_ENOUGH_VERTICES, "S2CErrorCode out of sync");
+static_assert(S2C_ERROR_POLYGON_LOOPS_SHARE_EDGE == S2Error::POLYGON_LOOPS_SHARE_EDGE, "S2CErrorCode out of sync");
+static_assert(S2C_ERROR_OVERLAPPING_GEOMETRY == S2Error::OVERLAPPING_GEOMETRY, "S2CErrorCode out of sync");
+static_assert(S2C_ERROR_BUILDER_SNAP_RADIUS_TOO_SMALL == S2Error::BUILDER_SNAP_RADIUS_TOO_SMALL, "S2CErrorCode out of sync");
+static_assert(S2C_ERROR_UNKNOWN == S2Error::UNKNOWN, "S2CErrorCode out of sync");
+static_assert(S2C_ERROR_CANCELLED == S2Error::CANCELLED, "S2CErrorCode out of sync");
+
+// Per-thread copy of the most recent error; the string keeps its capacity so
+// repeated failures stop allocating and successes never do
+struct LastError {
+    int code = S2C_ERROR_OK;
+    std::string message;
+};
+
+static LastError& last_error() {
+    thread_local LastError last;
+    return last;
+}
+
+// Records an outcome in the thread's last error and, if given, in *error.
+// error->text is only allocated on failure.
+static void report_error(S2CError* error, int code, const char* message) {
+    LastError& last = last_error();
+    last.code = code;
+    if (code == S2C_ERROR_OK) {
+        last.message.clear();
+    } else {
+        last.message.assign(message ? message : "");
+    }
+    if (error) {
+        error->ok = (code == S2C_ERROR_OK);
+        error->code = code;
+        error->text = error->ok ? nullptr : copy_string(last.message);
+    }
+}
+
+static void report_error(S2CError* error, const S2Error& s2_error) {
+    report_error(error, static_cast<int>(s2_error.code()),
+                 s2_error.ok() ? nullptr : s2_error.text().c_str());
+}
+
+// Encodes value into a malloc'd buffer for the caller to free
+template <typename T>
+static char* encode_to_buffer(const T& value, size_t* length) {
+    Encoder encoder;
+    value.Encode(&encoder);
+    char* result = (char*)malloc(encoder.length());
+    if (!result) return nullptr;
+    memcpy(result, encoder.base(), encoder.length());
+    *length = encoder.length();
+    return result;
+}
+
+// Decodes into a fresh T and swaps it in only on success, so a bad encoding
+// leaves *target untouched
+template <typename T>
+static bool decode_into(const char* data, size_t length, std::unique_ptr<T>* target) {
+    if (!data) return false;
+    Decoder decoder(data, length);
+    auto decoded = std::make_unique<T>();
+    if (!decoded->Decode(&decoder)) return false;
+    *target = std::move(decoded);
+    return true;
+}
+
+// Reads the i-th vertex of a flat (x, y, z) coordinate buffer
+static inline S2Point xyz_point(const double* xyz, size_t i) {
+    return S2Point(xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2]);
+}
+
+static void* arena_allocate(S2CArena* arena, size_t size, size_t align) {
+    while (arena->current < arena->blocks.size()) {
+        S2CArena::Block& block = arena->blocks[arena->current];
+        size_t start = (arena->offset + align - 1) & ~(align - 1);
+        if (start + size <= block.size) {
+            arena->offset = start + size;
+            arena->bytes_used += size;
+            return block.data.get() + start;
+        }
+        ++arena->current;
+        arena->offset = 0;
+    }
+    size_t block_size = std::max(arena->block_size, size + align);
+    arena->blocks.push_back({std::unique_ptr<char[]>(new char[block_size]), block_size});
+    arena->current = arena->blocks.size() - 1;
+    arena->offset = 0;
+    return arena_allocate(arena, size, align);
+}
+
+template <typename T, typename... Args>
+static T* arena_new(S2CArena* arena, Args&&... args) {
+    T* object = ::new (arena_allocate(arena, sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+    if (!std::is_trivially_destructible<T>::value) {
+        arena->destructors.push_back({object, [](void* p) { static_cast<T*>(p)->~T(); }});
+    }
+    return object;
+}
+
+// Worker threads shared by the batch operations. Jobs are run in submission
+// order; workers drain the queue before the pool shuts down.
+struct S2CThreadPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable job_ready;
+    std::deque<std::function<void()>> jobs;
+    bool stopping = false;
+};
+
+static void thread_pool_worker(S2CThreadPool* pool) {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(pool->mutex);
+            pool->job_ready.wait(lock, [pool] { return pool->stopping || !pool->jobs.empty(); });
+            if (pool->jobs.empty()) return;
+            job = std::move(pool->jobs.front());
+            pool->jobs.pop_front();
+        }
+        job();
+    }
+}
+
+static void thread_pool_submit(S2CThreadPool* pool, std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->jobs.push_back(std::move(job));
+    }
+    pool->job_ready.notify_one();
+}
+
+static S2CThreadPool* thread_pool_start(int num_threads, bool pin_threads) {
+    unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (num_threads <= 0) num_threads = hardware_threads;
+    auto* pool = new S2CThreadPool;
+    for (int i = 0; i < num_threads; ++i) {
+        pool->workers.emplace_back(thread_pool_worker, pool);
+#ifdef __linux__
+        if (pin_threads) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(i % hardware_threads, &cpus);
+            pthread_setaffinity_np(pool->workers.back().native_handle(), sizeof(cpus), &cpus);
+        }
+#else
+        (void)pin_threads;
+#endif
+    }
+    return pool;
+}
+
+// The library-owned pool used when callers don't pass one. The calling thread
+// also takes part in parallel loops, so it keeps one hardware thread free.
+// Never destroyed, so it stays usable from other static destructors.
+static S2CThreadPool* default_thread_pool() {
+    static S2CThreadPool* pool = thread_pool_start(std::max(2u, std::thread::hardware_concurrency()) - 1, false);
+    return pool;
+}
+
+// State of one parallel loop. Each participant owns a contiguous range of
+// task indices packed as (begin << 32) | end; when its range runs dry it
+// steals the upper half of another participant's range. Ranges stay
+// contiguous, so inputs ordered by S2CellId keep their locality per thread.
+struct ParallelLoop {
+    explicit ParallelLoop(int num_slots) : ranges(num_slots) {}
+    std::vector<std::atomic<uint64_t>> ranges;
+    std::atomic<int> remaining{0};
+    const std::function<void(int)>* task = nullptr;
+    std::mutex mutex;
+    std::condition_variable finished;
+};
+
+static inline uint64_t pack_range(uint32_t begin, uint32_t end) {
+    return (static_cast<uint64_t>(begin) << 32) | end;
+}
+
+static bool claim_task(std::atomic<uint64_t>& range, int* index) {
+    uint64_t r = range.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t begin = r >> 32, end = static_cast<uint32_t>(r);
+        if (begin >= end) return false;
+        if (range.compare_exchange_weak(r, pack_range(begin + 1, end), std::memory_order_acq_rel)) {
+            *index = begin;
+            return true;
+        }
+    }
+}
+
+static bool steal_tasks(ParallelLoop* loop, int victim, int thief) {
+    std::atomic<uint64_t>& range = loop->ranges[victim];
+    uint64_t r = range.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t begin = r >> 32, end = static_cast<uint32_t>(r);
+        if (begin >= end) return false;
+        uint32_t mid = begin + (end - begin) / 2;
+        if (range.compare_exchange_weak(r, pack_range(begin, mid), std::memory_order_acq_rel)) {
+            // The thief's own range is empty, so no one else is touching it
+            loop->ranges[thief].store(pack_range(mid, end), std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+static void run_loop_slot(ParallelLoop* loop, int slot) {
+    int num_slots = loop->ranges.size();
+    for (;;) {
+        int index;
+        while (claim_task(loop->ranges[slot], &index)) {
+            (*loop->task)(index);
+            if (loop->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(loop->mutex);
+                loop->finished.notify_all();
+            }
+        }
+        bool stole = false;
+        for (int k = 1; k < num_slots && !stole; ++k) {
+            stole = steal_tasks(loop, (slot + k) % num_slots, slot);
+        }
+        if (!stole) return;
+    }
+}
+
+// Runs task(0) .. task(num_tasks - 1) on the calling thread plus workers of
+// pool (NULL for the library pool), using at most num_threads threads (<= 0
+// for all of them). Neighbouring task indices tend to run on the same thread.
+// Safe to call from a pool worker: the caller steals any work that idle
+// helpers have not picked up yet.
+static void run_parallel(S2CThreadPool* pool, int num_threads, int num_tasks,
+                         const std::function<void(int)>& task) {
+    if (num_tasks <= 0) return;
+    if (!pool) pool = default_thread_pool();
+    int max_threads = static_cast<int>(pool->workers.size()) + 1;
+    if (num_threads <= 0 || num_threads > max_threads) num_threads = max_threads;
+    num_threads = std::min(num_threads, num_tasks);
+    if (num_threads == 1) {
+        for (int i = 0; i < num_tasks; ++i) task(i);
+        return;
+    }
+
+    auto loop = std::make_shared<ParallelLoop>(num_threads);
+    loop->task = &task;
+    loop->remaining.store(num_tasks, std::memory_order_relaxed);
+    for (int slot = 0; slot < num_threads; ++slot) {
+        uint32_t begin = static_cast<int64_t>(num_tasks) * slot / num_threads;
+        uint32_t end = static_cast<int64_t>(num_tasks) * (slot + 1) / num_threads;
+        loop->ranges[slot].store(pack_range(begin, end), std::memory_order_relaxed);
+    }
+    for (int slot = 1; slot < num_threads; ++slot) {
+        thread_pool_submit(pool, [loop, slot] { run_loop_slot(loop.get(), slot); });
+    }
+    run_loop_slot(loop.get(), 0);
+    std::unique_lock<std::mutex> lock(loop->mutex);
+    loop->finished.wait(lock, [&] { return loop->remaining.load(std::memory_order_acquire) == 0; });
+}
+
+static void run_parallel(int num_threads, int num_tasks, const std::function<void(int)>& task) {
+    run_parallel(nullptr, num_threads, num_tasks, task);
+}
+
+static inline bool is_cancelled(const std::atomic<bool>* cancelled) {
+    return cancelled && cancelled->load(std::memory_order_relaxed);
+}
+
+// Shared between an S2CTask handle and the pool job running it, so either
+// side may finish first.
+struct TaskState {
+    std::mutex mutex;
+    std::condition_variable changed;
+    S2CTaskStatus status = S2C_TASK_PENDING;
+    bool callback_done = false;
+    bool detached = false;  // Handle destroyed while pending; the job frees it
+    std::atomic<bool> cancelled{false};
+    int64_t result = 0;
+};
+
+struct S2CTask { std::shared_ptr<TaskState> state; };
+
+// Task whose completion callback is running on this thread, if any
+static thread_local const S2CTask* current_callback_task = nullptr;
+
+// Queues work on pool (NULL for the library pool). work reports its result
+// through *result and returns false if it stopped early because the task was
+// cancelled; it should check the flag between chunks.
+static S2CTask* submit_task(S2CThreadPool* pool, S2CTaskCallback callback, void* user_data,
+                            std::function<bool(const std::atomic<bool>*, int64_t*)> work) {
+    if (!pool) pool = default_thread_pool();
+    auto* task = new S2CTask{std::make_shared<TaskState>()};
+    std::shared_ptr<TaskState> state = task->state;
+    thread_pool_submit(pool, [task, state, callback, user_data, work = std::move(work)] {
+        bool started;
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            if (state->detached) {
+                lock.unlock();
+                delete task;
+                return;
+            }
+            started = !state->cancelled.load(std::memory_order_relaxed);
+            if (started) state->status = S2C_TASK_RUNNING;
+        }
+        int64_t result = 0;
+        bool completed = started && work(&state->cancelled, &result);
+        S2CTaskStatus status = completed ? S2C_TASK_DONE : S2C_TASK_CANCELLED;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->result = result;
+            state->status = status;
+        }
+        state->changed.notify_all();
+        if (callback) {
+            current_callback_task = task;
+            callback(task, status, user_data);
+            current_callback_task = nullptr;
+        }
+        {
+            // The handle may be destroyed as soon as this is set
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->callback_done = true;
+        }
+        state->changed.notify_all();
+    });
+    return task;
+}
+
 // S2Point functions
 S2CPoint* s2c_point_new(double x, double y, double z) {
     auto* p = new S2CPoint;
@@ -1028,6 +1687,409 @@ void s2c_cellid_append_vertex_neighbors(const S2CCellId* cellid, int level, S2CC
     }
 }
 
+// S2CellId array kernels
+// Branch-free bit arithmetic on raw ids, equivalent to the inline S2CellId
+// methods without their debug checks so that the loops vectorize. On x86-64
+// ELF targets each kernel is also compiled for AVX2 and the loader selects
+// the variant for the running CPU; other targets (including NEON, which is
+// baseline on AArch64) use the compiler's auto-vectorization.
+#if defined(__x86_64__) && defined(__ELF__) && defined(__GNUC__) && \
+    (!defined(__clang__) || __clang_major__ >= 14) && !defined(S2C_NO_MULTIVERSIONING)
+#define S2C_TARGET_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define S2C_TARGET_CLONES
+#endif
+
+S2C_TARGET_CLONES
+static void cellid_parent_kernel(const uint64_t* ids, size_t n, uint64_t new_lsb, uint64_t* out) {
+    const uint64_t mask = 0 - new_lsb;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = (ids[i] & mask) | new_lsb;
+    }
+}
+
+// direction is -1 for child_begin and +1 for child_end
+S2C_TARGET_CLONES
+static void cellid_child_kernel(const uint64_t* ids, size_t n, uint64_t new_lsb, int direction, uint64_t* out) {
+    const uint64_t sign = direction < 0 ? ~uint64_t{0} : 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t lsb = ids[i] & (0 - ids[i]);
+        out[i] = ids[i] + ((lsb ^ sign) - sign) + new_lsb;
+    }
+}
+
+S2C_TARGET_CLONES
+static void cellid_range_kernel(const uint64_t* ids, size_t n, int direction, uint64_t* out) {
+    const uint64_t sign = direction < 0 ? ~uint64_t{0} : 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t half = (ids[i] & (0 - ids[i])) - 1;
+        out[i] = ids[i] + ((half ^ sign) - sign);
+    }
+}
+
+S2C_TARGET_CLONES
+static void cellid_contains_kernel(const uint64_t* a, const uint64_t* b, size_t n, uint8_t* out) {
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t half = (a[i] & (0 - a[i])) - 1;
+        out[i] = (b[i] >= a[i] - half) & (b[i] <= a[i] + half);
+    }
+}
+
+S2C_TARGET_CLONES
+static void cellid_level_kernel(const uint64_t* ids, size_t n, uint8_t* out) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = S2CellId::kMaxLevel - (absl::countr_zero(ids[i]) >> 1);
+    }
+}
+
+S2C_TARGET_CLONES
+static void cellid_face_kernel(const uint64_t* ids, size_t n, uint8_t* out) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = ids[i] >> S2CellId::kPosBits;
+    }
+}
+
+void s2c_cellid_parent_batch(const uint64_t* ids, size_t n, int level, uint64_t* out) {
+    if (!ids || !out || level < 0 || level > S2CellId::kMaxLevel) return;
+    cellid_parent_kernel(ids, n, S2CellId::lsb_for_level(level), out);
+}
+
+void s2c_cellid_child_begin_batch(const uint64_t* ids, size_t n, int level, uint64_t* out) {
+    if (!ids || !out || level < 0 || level > S2CellId::kMaxLevel) return;
+    cellid_child_kernel(ids, n, S2CellId::lsb_for_level(level), -1, out);
+}
+
+void s2c_cellid_child_end_batch(const uint64_t* ids, size_t n, int level, uint64_t* out) {
+    if (!ids || !out || level < 0 || level > S2CellId::kMaxLevel) return;
+    cellid_child_kernel(ids, n, S2CellId::lsb_for_level(level), 1, out);
+}
+
+void s2c_cellid_range_min_batch(const uint64_t* ids, size_t n, uint64_t* out) {
+    if (!ids || !out) return;
+    cellid_range_kernel(ids, n, -1, out);
+}
+
+void s2c_cellid_range_max_batch(const uint64_t* ids, size_t n, uint64_t* out) {
+    if (!ids || !out) return;
+    cellid_range_kernel(ids, n, 1, out);
+}
+
+void s2c_cellid_contains_batch(const uint64_t* a, const uint64_t* b, size_t n, uint8_t* out) {
+    if (!a || !b || !out) return;
+    cellid_contains_kernel(a, b, n, out);
+}
+
+void s2c_cellid_level_batch(const uint64_t* ids, size_t n, uint8_t* out) {
+    if (!ids || !out) return;
+    cellid_level_kernel(ids, n, out);
+}
+
+void s2c_cellid_face_batch(const uint64_t* ids, size_t n, uint8_t* out) {
+    if (!ids || !out) return;
+    cellid_face_kernel(ids, n, out);
+}
+
+// S2CellId neighbor enumeration into caller buffers
+void s2c_cellid_edge_neighbor_ids(uint64_t id, uint64_t neighbors[4]) {
+    if (!neighbors) return;
+    S2CellId cell(id);
+    if (!cell.is_valid()) {
+        std::fill(neighbors, neighbors + 4, S2CellId::None().id());
+        return;
+    }
+    S2CellId nb[4];
+    cell.GetEdgeNeighbors(nb);
+    for (int i = 0; i < 4; ++i) {
+        neighbors[i] = nb[i].id();
+    }
+}
+
+// Copies up to capacity ids and returns the full count, like snprintf
+static int copy_neighbor_ids(const std::vector<S2CellId>& nbrs, uint64_t* out, int capacity) {
+    int count = nbrs.size();
+    for (int i = 0; i < std::min(count, capacity); ++i) {
+        out[i] = nbrs[i].id();
+    }
+    return count;
+}
+
+int s2c_cellid_all_neighbor_ids(uint64_t id, int nbr_level, uint64_t* out, int capacity) {
+    S2CellId cell(id);
+    if (!cell.is_valid() || nbr_level < cell.level() || nbr_level > S2CellId::kMaxLevel) return 0;
+    if (!out) capacity = 0;
+    // Reused per thread so that steady-state calls do not allocate
+    thread_local std::vector<S2CellId> nbrs;
+    nbrs.clear();
+    cell.AppendAllNeighbors(nbr_level, &nbrs);
+    return copy_neighbor_ids(nbrs, out, capacity);
+}
+
+int s2c_cellid_vertex_neighbor_ids(uint64_t id, int level, uint64_t* out, int capacity) {
+    S2CellId cell(id);
+    if (!cell.is_valid() || level < 0 || level >= cell.level()) return 0;
+    if (!out) capacity = 0;
+    thread_local std::vector<S2CellId> nbrs;
+    nbrs.clear();
+    cell.AppendVertexNeighbors(level, &nbrs);
+    return copy_neighbor_ids(nbrs, out, capacity);
+}
+
+// Appends the cells within k neighbor steps of id (including id), sorted
+static void append_k_ring(S2CellId id, int k, std::vector<S2CellId>* ring,
+                          std::vector<S2CellId>* frontier, std::vector<S2CellId>* candidates) {
+    size_t start = ring->size();
+    ring->push_back(id);
+    frontier->assign(1, id);
+    for (int step = 0; step < k && !frontier->empty(); ++step) {
+        candidates->clear();
+        for (S2CellId cell : *frontier) {
+            cell.AppendAllNeighbors(id.level(), candidates);
+        }
+        std::sort(candidates->begin(), candidates->end());
+        candidates->erase(std::unique(candidates->begin(), candidates->end()), candidates->end());
+
+        // The new frontier is every candidate not already in the ring
+        frontier->clear();
+        std::set_difference(candidates->begin(), candidates->end(), ring->begin() + start, ring->end(),
+                            std::back_inserter(*frontier));
+        size_t middle = ring->size();
+        ring->insert(ring->end(), frontier->begin(), frontier->end());
+        std::inplace_merge(ring->begin() + start, ring->begin() + middle, ring->end());
+    }
+}
+
+int64_t s2c_cellid_k_ring_batch(const uint64_t* ids, size_t n, int k, int num_threads,
+                                uint64_t** out_ids, int64_t** out_offsets) {
+    if (out_ids) *out_ids = nullptr;
+    if (out_offsets) *out_offsets = nullptr;
+    if (!ids || !out_ids || !out_offsets || k < 0) return 0;
+
+    const size_t kChunkSize = 256;
+    int num_chunks = (n + kChunkSize - 1) / kChunkSize;
+    std::vector<std::vector<S2CellId>> chunk_cells(num_chunks);
+    std::vector<int64_t> counts(n, 0);
+    run_parallel(num_threads, num_chunks, [&](int chunk) {
+        std::vector<S2CellId> frontier, candidates;
+        size_t end = std::min(n, (chunk + 1) * kChunkSize);
+        for (size_t i = chunk * kChunkSize; i < end; ++i) {
+            S2CellId id(ids[i]);
+            if (!id.is_valid()) continue;
+            size_t before = chunk_cells[chunk].size();
+            append_k_ring(id, k, &chunk_cells[chunk], &frontier, &candidates);
+            counts[i] = chunk_cells[chunk].size() - before;
+        }
+    });
+
+    *out_offsets = (int64_t*)malloc(sizeof(int64_t) * (n + 1));
+    (*out_offsets)[0] = 0;
+    for (size_t i = 0; i < n; ++i) {
+        (*out_offsets)[i + 1] = (*out_offsets)[i] + counts[i];
+    }
+    int64_t total = (*out_offsets)[n];
+    *out_ids = (uint64_t*)malloc(sizeof(uint64_t) * std::max<int64_t>(total, 1));
+    uint64_t* dst = *out_ids;
+    for (const auto& cells : chunk_cells) {
+        for (S2CellId cell : cells) {
+            *dst++ = cell.id();
+        }
+    }
+    return total;
+}
+
+// S2CellId batch token conversion
+// Tokens are the id in lowercase hex with trailing zero nibbles removed
+// ("X" for S2CellId::None()), at most 16 characters. Work is split into
+// fixed-size blocks so that threading never changes the output.
+static const size_t kTokenBlockSize = 4096;
+
+static void run_token_blocks(size_t n, int num_threads, const std::function<void(size_t, size_t)>& block) {
+    int num_blocks = (n + kTokenBlockSize - 1) / kTokenBlockSize;
+    run_parallel(num_threads, num_blocks, [&](int b) {
+        size_t begin = b * kTokenBlockSize;
+        block(begin, std::min(n, begin + kTokenBlockSize));
+    });
+}
+
+static inline int token_length(uint64_t id) {
+    return id == 0 ? 1 : 16 - (absl::countr_zero(id) >> 2);
+}
+
+// Writes the token for id and returns its length
+static inline int encode_token(uint64_t id, char* out) {
+    if (id == 0) {
+        out[0] = 'X';
+        return 1;
+    }
+    int length = token_length(id);
+    for (int k = 0; k < length; ++k) {
+        int nibble = (id >> (60 - 4 * k)) & 0xF;
+        // '0' + n for n < 10, 'a' + n - 10 otherwise
+        out[k] = '0' + nibble + (((9 - nibble) >> 31) & ('a' - '0' - 10));
+    }
+    return length;
+}
+
+// Same result as S2CellId::FromToken: invalid tokens decode to 0
+static inline uint64_t decode_token(const char* token, size_t length) {
+    if (length > 16) return 0;
+    uint64_t id = 0;
+    bool valid = true;
+    for (size_t k = 0; k < length; ++k) {
+        unsigned c = static_cast<unsigned char>(token[k]);
+        valid &= (c - '0' < 10u) | ((c | 0x20) - 'a' < 6u);
+        uint64_t nibble = (c & 0xF) + 9 * ((c >> 6) & 1);
+        id |= nibble << (60 - 4 * k);
+    }
+    return valid ? id : 0;
+}
+
+int64_t s2c_cellid_to_tokens_packed(const uint64_t* ids, size_t n, char* bytes, int64_t* offsets, int num_threads) {
+    if (!ids || !bytes || !offsets) return 0;
+    offsets[0] = 0;
+    for (size_t i = 0; i < n; ++i) {
+        offsets[i + 1] = offsets[i] + token_length(ids[i]);
+    }
+    run_token_blocks(n, num_threads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            encode_token(ids[i], bytes + offsets[i]);
+        }
+    });
+    return offsets[n];
+}
+
+bool s2c_cellid_to_tokens_fixed(const uint64_t* ids, size_t n, char* out, size_t stride, int num_threads) {
+    if (!ids || !out || stride < 16) return false;
+    run_token_blocks(n, num_threads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            char* token = out + i * stride;
+            int length = encode_token(ids[i], token);
+            memset(token + length, 0, stride - length);
+        }
+    });
+    return true;
+}
+
+size_t s2c_cellid_from_tokens_packed(const char* bytes, const int64_t* offsets, size_t n, uint64_t* out,
+                                     int num_threads) {
+    if (!bytes || !offsets || !out) return 0;
+    std::atomic<size_t> num_valid(0);
+    run_token_blocks(n, num_threads, [&](size_t begin, size_t end) {
+        size_t valid = 0;
+        for (size_t i = begin; i < end; ++i) {
+            out[i] = decode_token(bytes + offsets[i], offsets[i + 1] - offsets[i]);
+            valid += out[i] != 0;
+        }
+        num_valid += valid;
+    });
+    return num_valid;
+}
+
+size_t s2c_cellid_from_tokens_fixed(const char* tokens, size_t n, size_t stride, uint64_t* out, int num_threads) {
+    if (!tokens || !out || stride == 0) return 0;
+    std::atomic<size_t> num_valid(0);
+    run_token_blocks(n, num_threads, [&](size_t begin, size_t end) {
+        size_t valid = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const char* token = tokens + i * stride;
+            out[i] = decode_token(token, strnlen(token, stride));
+            valid += out[i] != 0;
+        }
+        num_valid += valid;
+    });
+    return num_valid;
+}
+
+// S2CellId (Hilbert curve) ordering of point batches
+// Points are keyed by leaf cell id and sorted with an LSD radix sort on 8-bit
+// digits. Each pass histograms and scatters disjoint blocks in parallel, which
+// keeps the sort stable, and digits shared by every key are skipped.
+static const size_t kParallelSortThreshold = 1 << 16;
+
+static void sort_points_by_cellid(const double* xyz, size_t n, uint32_t* perm, std::vector<uint64_t>* sorted_keys) {
+    int num_blocks = n < kParallelSortThreshold ? 1 : std::max(1u, std::thread::hardware_concurrency());
+    size_t block_size = (n + num_blocks - 1) / num_blocks;
+    auto block_begin = [&](int b) { return std::min(n, b * block_size); };
+    auto block_end = [&](int b) { return std::min(n, (b + 1) * block_size); };
+
+    std::vector<uint64_t> keys(n), keys_tmp(n);
+    std::vector<uint32_t> perm_tmp(n);
+    run_parallel(num_blocks, num_blocks, [&](int b) {
+        for (size_t i = block_begin(b); i < block_end(b); ++i) {
+            keys[i] = S2CellId(xyz_point(xyz, i)).id();
+            perm[i] = i;
+        }
+    });
+
+    uint64_t* src_keys = keys.data();
+    uint64_t* dst_keys = keys_tmp.data();
+    uint32_t* src_perm = perm;
+    uint32_t* dst_perm = perm_tmp.data();
+    std::vector<size_t> counts(num_blocks * 256);
+    for (int shift = 0; shift < 64; shift += 8) {
+        run_parallel(num_blocks, num_blocks, [&](int b) {
+            size_t* c = &counts[b * 256];
+            std::fill(c, c + 256, 0);
+            for (size_t i = block_begin(b); i < block_end(b); ++i) {
+                ++c[(src_keys[i] >> shift) & 0xFF];
+            }
+        });
+
+        // Exclusive prefix sum in (digit, block) order
+        size_t sum = 0;
+        bool shared_digit = false;
+        for (int d = 0; d < 256; ++d) {
+            size_t digit_start = sum;
+            for (int b = 0; b < num_blocks; ++b) {
+                size_t c = counts[b * 256 + d];
+                counts[b * 256 + d] = sum;
+                sum += c;
+            }
+            shared_digit |= sum - digit_start == n;
+        }
+        if (shared_digit) continue;
+
+        run_parallel(num_blocks, num_blocks, [&](int b) {
+            size_t* c = &counts[b * 256];
+            for (size_t i = block_begin(b); i < block_end(b); ++i) {
+                size_t pos = c[(src_keys[i] >> shift) & 0xFF]++;
+                dst_keys[pos] = src_keys[i];
+                dst_perm[pos] = src_perm[i];
+            }
+        });
+        std::swap(src_keys, dst_keys);
+        std::swap(src_perm, dst_perm);
+    }
+
+    if (src_perm != perm) memcpy(perm, src_perm, sizeof(uint32_t) * n);
+    if (sorted_keys) sorted_keys->assign(src_keys, src_keys + n);
+}
+
+bool s2c_sort_points_by_cellid(const double* xyz, size_t n, uint32_t* permutation_out) {
+    if (!xyz || !permutation_out || n > UINT32_MAX) return false;
+    sort_points_by_cellid(xyz, n, permutation_out, nullptr);
+    return true;
+}
+
+bool s2c_partition_points_by_cellid(const double* xyz, size_t n, int num_parts, uint32_t* permutation_out,
+                                    size_t* part_offsets, uint64_t* part_ranges) {
+    if (!xyz || !permutation_out || !part_offsets || num_parts <= 0 || n > UINT32_MAX) return false;
+    std::vector<uint64_t> keys;
+    sort_points_by_cellid(xyz, n, permutation_out, &keys);
+
+    // Equal-sized runs of the sorted order are compact regions of the sphere
+    for (int p = 0; p <= num_parts; ++p) {
+        part_offsets[p] = n * p / num_parts;
+    }
+    if (part_ranges) {
+        for (int p = 0; p < num_parts; ++p) {
+            bool empty = part_offsets[p] == part_offsets[p + 1];
+            part_ranges[2 * p] = empty ? 0 : keys[part_offsets[p]];
+            part_ranges[2 * p + 1] = empty ? 0 : keys[part_offsets[p + 1] - 1];
+        }
+    }
+    return true;
+}
+
 // S2Loop functions
 S2CLoop* s2c_loop_new(void) {
     auto* loop = new S2CLoop;
@@ -1070,11 +2132,9 @@ S2CPoint* s2c_loop_vertex(const S2CLoop* loop, int i) {
 
 bool s2c_loop_is_valid(const S2CLoop* loop, S2CError* error) {
     if (!loop || !loop->loop) return false;
-    bool valid = loop->loop->IsValid();
-    if (error) {
-        error->ok = valid;
-        error->text = valid ? nullptr : copy_string("Loop validation failed");
-    }
+    S2Error s2_error;
+    bool valid = !loop->loop->FindValidationError(&s2_error);
+    report_error(error, s2_error);
     return valid;
 }
 
@@ -1239,17 +2299,14 @@ bool s2c_loop_may_intersect_cell(const S2CLoop* loop, const S2CCell* cell) {
 }
 
 // Serialization
-void s2c_loop_encode(const S2CLoop* loop, void* encoder) {
-    // TODO: Implement proper encoder wrapper
-    (void)loop;
-    (void)encoder;
+char* s2c_loop_encode(const S2CLoop* loop, size_t* length) {
+    if (length) *length = 0;
+    if (!loop || !loop->loop || !length) return nullptr;
+    return encode_to_buffer(*loop->loop, length);
 }
 
-bool s2c_loop_decode(void* decoder, S2CLoop** loop) {
-    // TODO: Implement proper decoder wrapper
-    (void)decoder;
-    (void)loop;
-    return false;
+bool s2c_loop_decode(S2CLoop* loop, const char* data, size_t length) {
+    return loop && decode_into(data, length, &loop->loop);
 }
 
 // S2Polyline functions
@@ -1404,11 +2461,9 @@ S2CPolyline* s2c_polyline_get_suffix(const S2CPolyline* polyline, double fractio
 
 bool s2c_polyline_is_valid(const S2CPolyline* polyline, S2CError* error) {
     if (!polyline || !polyline->polyline) return false;
-    bool valid = polyline->polyline->IsValid();
-    if (error) {
-        error->ok = valid;
-        error->text = valid ? nullptr : copy_string("Polyline validation failed");
-    }
+    S2Error s2_error;
+    bool valid = !polyline->polyline->FindValidationError(&s2_error);
+    report_error(error, s2_error);
     return valid;
 }
 
@@ -1446,32 +2501,349 @@ S2CPolyline* s2c_polyline_clone(const S2CPolyline* polyline) {
 }
 
 char* s2c_polyline_encode(const S2CPolyline* polyline, size_t* length) {
-    // TODO: Implement encoding
     if (length) *length = 0;
-    return nullptr;
+    if (!polyline || !polyline->polyline || !length) return nullptr;
+    return encode_to_buffer(*polyline->polyline, length);
 }
 
 bool s2c_polyline_decode(S2CPolyline* polyline, const char* data, size_t length) {
-    // TODO: Implement decoding
-    return false;
+    return polyline && decode_into(data, length, &polyline->polyline);
 }
 
-// S2Polygon functions
-S2CPolygon* s2c_polygon_new(void) {
-    auto* polygon = new S2CPolygon;
-    polygon->polygon = std::make_unique<S2Polygon>();
-    return polygon;
+// Polyline simplification functions
+static std::vector<S2Point> xyz_points(const double* xyz, int begin, int end) {
+    std::vector<S2Point> points;
+    points.reserve(end - begin);
+    for (int i = begin; i < end; ++i) {
+        points.push_back(xyz_point(xyz, i));
+    }
+    return points;
 }
 
-S2CPolygon* s2c_polygon_new_from_loop(S2CLoop* loop) {
-    if (!loop || !loop->loop) return nullptr;
-    auto* polygon = new S2CPolygon;
-    // Transfer ownership of the loop
-    polygon->polygon = std::make_unique<S2Polygon>(std::move(loop->loop));
-    return polygon;
+// Writes the indices (relative to the chain start) of the subsampled vertices
+static int subsample_chain(const double* xyz, int begin, int end, S1Angle tolerance, int* indices) {
+    if (end - begin <= 0) return 0;
+    S2Polyline polyline(xyz_points(xyz, begin, end), S2Debug::DISABLE);
+    std::vector<int> kept;
+    polyline.SubsampleVertices(tolerance, &kept);
+    std::copy(kept.begin(), kept.end(), indices);
+    return kept.size();
 }
 
-S2CPolygon* s2c_polygon_new_from_loops(S2CLoop** loops, int num_loops) {
+// Greedy S2PolylineSimplifier pass: each output edge passes within tolerance
+// of every input vertex it replaces.
+static int simplify_chain(const double* xyz, int begin, int end, S1ChordAngle tolerance, double* out_xyz) {
+    int n = end - begin;
+    if (n <= 0) return 0;
+    int count = 0;
+    auto emit = [&](int i) {
+        out_xyz[3 * count] = xyz[3 * i];
+        out_xyz[3 * count + 1] = xyz[3 * i + 1];
+        out_xyz[3 * count + 2] = xyz[3 * i + 2];
+        ++count;
+    };
+
+    emit(begin);
+    if (n == 1) return count;
+    S2PolylineSimplifier simplifier;
+    simplifier.Init(xyz_point(xyz, begin));
+    for (int i = begin + 1; i < end; ++i) {
+        S2Point v = xyz_point(xyz, i);
+        if (!simplifier.Extend(v)) {
+            emit(i - 1);
+            simplifier.Init(xyz_point(xyz, i - 1));
+        }
+        simplifier.TargetDisc(v, tolerance);
+    }
+    emit(end - 1);
+    return count;
+}
+
+int s2c_polyline_subsample_vertices(const S2CPolyline* polyline, const S1CAngle* tolerance, int* indices) {
+    if (!polyline || !polyline->polyline || !tolerance || !indices) return 0;
+    std::vector<int> kept;
+    polyline->polyline->SubsampleVertices(tolerance->angle, &kept);
+    std::copy(kept.begin(), kept.end(), indices);
+    return kept.size();
+}
+
+int s2c_polyline_subsample_vertices_xyz(const double* xyz, int num_vertices, double tolerance_radians, int* indices) {
+    if (!xyz || !indices || num_vertices <= 0) return 0;
+    return subsample_chain(xyz, 0, num_vertices, S1Angle::Radians(tolerance_radians), indices);
+}
+
+int s2c_polyline_simplify_xyz(const double* xyz, int num_vertices, double tolerance_radians, double* out_xyz) {
+    if (!xyz || !out_xyz || num_vertices <= 0) return 0;
+    return simplify_chain(xyz, 0, num_vertices, S1ChordAngle(S1Angle::Radians(tolerance_radians)), out_xyz);
+}
+
+int s2c_polylines_subsample_batch(const double* xyz, const int* offsets, int num_polylines,
+                                  double tolerance_radians, int* out_indices, int* out_offsets) {
+    if (!xyz || !offsets || !out_indices || !out_offsets || num_polylines <= 0) return 0;
+    S1Angle tolerance = S1Angle::Radians(tolerance_radians);
+    int total = 0;
+    out_offsets[0] = 0;
+    for (int i = 0; i < num_polylines; ++i) {
+        total += subsample_chain(xyz, offsets[i], offsets[i + 1], tolerance, out_indices + total);
+        out_offsets[i + 1] = total;
+    }
+    return total;
+}
+
+int s2c_polylines_simplify_batch(const double* xyz, const int* offsets, int num_polylines,
+                                 double tolerance_radians, double* out_xyz, int* out_offsets) {
+    if (!xyz || !offsets || !out_xyz || !out_offsets || num_polylines <= 0) return 0;
+    S1ChordAngle tolerance(S1Angle::Radians(tolerance_radians));
+    int total = 0;
+    out_offsets[0] = 0;
+    for (int i = 0; i < num_polylines; ++i) {
+        total += simplify_chain(xyz, offsets[i], offsets[i + 1], tolerance, out_xyz + 3 * total);
+        out_offsets[i + 1] = total;
+    }
+    return total;
+}
+
+// S2PolylineAlignment functions
+static std::unique_ptr<S2Polyline> xyz_polyline(const double* xyz, int begin, int end) {
+    return std::make_unique<S2Polyline>(xyz_points(xyz, begin, end), S2Debug::DISABLE);
+}
+
+static std::vector<std::unique_ptr<S2Polyline>> xyz_polylines(const double* xyz, const int* offsets, int num_polylines) {
+    std::vector<std::unique_ptr<S2Polyline>> polylines;
+    polylines.reserve(num_polylines);
+    for (int i = 0; i < num_polylines; ++i) {
+        polylines.push_back(xyz_polyline(xyz, offsets[i], offsets[i + 1]));
+    }
+    return polylines;
+}
+
+// Alignment asserts on empty polylines, so every range must be non-empty
+static bool valid_polyline_offsets(const int* offsets, int num_polylines) {
+    for (int i = 0; i < num_polylines; ++i) {
+        if (offsets[i] < 0 || offsets[i + 1] <= offsets[i]) return false;
+    }
+    return true;
+}
+
+static double copy_alignment(const s2polyline_alignment::VertexAlignment& alignment,
+                             int* warp_path, int* path_length) {
+    if (warp_path) {
+        for (size_t i = 0; i < alignment.warp_path.size(); ++i) {
+            warp_path[2 * i] = alignment.warp_path[i].first;
+            warp_path[2 * i + 1] = alignment.warp_path[i].second;
+        }
+    }
+    if (path_length) *path_length = alignment.warp_path.size();
+    return alignment.alignment_cost;
+}
+
+double s2c_polyline_exact_vertex_alignment_cost(const double* a_xyz, int num_a, const double* b_xyz, int num_b) {
+    if (!a_xyz || !b_xyz || num_a <= 0 || num_b <= 0) return -1.0;
+    auto a = xyz_polyline(a_xyz, 0, num_a);
+    auto b = xyz_polyline(b_xyz, 0, num_b);
+    return s2polyline_alignment::GetExactVertexAlignmentCost(*a, *b);
+}
+
+double s2c_polyline_exact_vertex_alignment(const double* a_xyz, int num_a, const double* b_xyz, int num_b,
+                                           int* warp_path, int* path_length) {
+    if (path_length) *path_length = 0;
+    if (!a_xyz || !b_xyz || num_a <= 0 || num_b <= 0) return -1.0;
+    auto a = xyz_polyline(a_xyz, 0, num_a);
+    auto b = xyz_polyline(b_xyz, 0, num_b);
+    return copy_alignment(s2polyline_alignment::GetExactVertexAlignment(*a, *b), warp_path, path_length);
+}
+
+double s2c_polyline_approx_vertex_alignment(const double* a_xyz, int num_a, const double* b_xyz, int num_b,
+                                            int radius, int* warp_path, int* path_length) {
+    if (path_length) *path_length = 0;
+    if (!a_xyz || !b_xyz || num_a <= 0 || num_b <= 0) return -1.0;
+    auto a = xyz_polyline(a_xyz, 0, num_a);
+    auto b = xyz_polyline(b_xyz, 0, num_b);
+    auto alignment = radius < 0 ?
+        s2polyline_alignment::GetApproxVertexAlignment(*a, *b) :
+        s2polyline_alignment::GetApproxVertexAlignment(*a, *b, radius);
+    return copy_alignment(alignment, warp_path, path_length);
+}
+
+int s2c_polyline_medoid(const double* xyz, const int* offsets, int num_polylines, bool approx) {
+    if (!xyz || !offsets || num_polylines <= 0 || !valid_polyline_offsets(offsets, num_polylines)) return -1;
+    auto polylines = xyz_polylines(xyz, offsets, num_polylines);
+    s2polyline_alignment::MedoidOptions options;
+    options.set_approx(approx);
+    return s2polyline_alignment::GetMedoidPolyline(polylines, options);
+}
+
+int s2c_polyline_consensus(const double* xyz, const int* offsets, int num_polylines, bool approx,
+                           bool seed_medoid, int iteration_cap, double** out_xyz) {
+    if (out_xyz) *out_xyz = nullptr;
+    if (!xyz || !offsets || !out_xyz || num_polylines <= 0 || !valid_polyline_offsets(offsets, num_polylines)) {
+        return 0;
+    }
+    auto polylines = xyz_polylines(xyz, offsets, num_polylines);
+    s2polyline_alignment::ConsensusOptions options;
+    options.set_approx(approx);
+    options.set_seed_medoid(seed_medoid);
+    if (iteration_cap > 0) options.set_iteration_cap(iteration_cap);
+    auto consensus = s2polyline_alignment::GetConsensusPolyline(polylines, options);
+
+    int count = consensus->num_vertices();
+    *out_xyz = (double*)malloc(sizeof(double) * 3 * std::max(count, 1));
+    for (int i = 0; i < count; ++i) {
+        const S2Point& v = consensus->vertex(i);
+        (*out_xyz)[3 * i] = v.x();
+        (*out_xyz)[3 * i + 1] = v.y();
+        (*out_xyz)[3 * i + 2] = v.z();
+    }
+    return count;
+}
+
+bool s2c_polyline_alignment_cost_matrix(const double* xyz, const int* offsets, int num_polylines,
+                                        bool approx, int num_threads, double* costs) {
+    if (!xyz || !offsets || !costs || num_polylines <= 0 || !valid_polyline_offsets(offsets, num_polylines)) {
+        return false;
+    }
+    auto polylines = xyz_polylines(xyz, offsets, num_polylines);
+
+    size_t n = num_polylines;
+    run_parallel(num_threads, num_polylines, [&](int i) {
+        costs[i * n + i] = 0.0;
+        for (size_t j = i + 1; j < n; ++j) {
+            double cost = approx ?
+                s2polyline_alignment::GetApproxVertexAlignment(*polylines[i], *polylines[j]).alignment_cost :
+                s2polyline_alignment::GetExactVertexAlignmentCost(*polylines[i], *polylines[j]);
+            costs[i * n + j] = cost;
+            costs[j * n + i] = cost;
+        }
+    });
+    return true;
+}
+
+// S2EdgeTessellator functions
+S2CEdgeTessellator* s2c_edge_tessellator_new(S2CProjectionType projection, double scale, double tolerance_radians) {
+    if (scale <= 0) return nullptr;
+    auto* tessellator = new S2CEdgeTessellator;
+    if (projection == S2C_PROJECTION_MERCATOR) {
+        tessellator->projection = std::make_unique<S2::MercatorProjection>(scale);
+    } else {
+        tessellator->projection = std::make_unique<S2::PlateCarreeProjection>(scale);
+    }
+    tessellator->tessellator = std::make_unique<S2EdgeTessellator>(
+        tessellator->projection.get(), S1Angle::Radians(tolerance_radians));
+    return tessellator;
+}
+
+void s2c_edge_tessellator_destroy(S2CEdgeTessellator* tessellator) {
+    delete tessellator;
+}
+
+static void append_projected_chain(const S2CEdgeTessellator* tessellator, const double* xyz,
+                                   int begin, int end, std::vector<R2Point>* vertices) {
+    if (end - begin == 1) {
+        vertices->push_back(tessellator->projection->Project(xyz_point(xyz, begin)));
+        return;
+    }
+    std::vector<R2Point> chain;
+    for (int i = begin; i + 1 < end; ++i) {
+        tessellator->tessellator->AppendProjected(xyz_point(xyz, i), xyz_point(xyz, i + 1), &chain);
+    }
+    vertices->insert(vertices->end(), chain.begin(), chain.end());
+}
+
+static void append_unprojected_chain(const S2CEdgeTessellator* tessellator, const double* xy,
+                                     int begin, int end, std::vector<S2Point>* vertices) {
+    auto xy_point = [xy](int i) { return R2Point(xy[2 * i], xy[2 * i + 1]); };
+    if (end - begin == 1) {
+        vertices->push_back(tessellator->projection->Unproject(xy_point(begin)));
+        return;
+    }
+    std::vector<S2Point> chain;
+    for (int i = begin; i + 1 < end; ++i) {
+        tessellator->tessellator->AppendUnprojected(xy_point(i), xy_point(i + 1), &chain);
+    }
+    vertices->insert(vertices->end(), chain.begin(), chain.end());
+}
+
+int s2c_edge_tessellator_project(const S2CEdgeTessellator* tessellator, const double* xyz, int num_vertices, double** out_xy) {
+    int offsets[2] = {0, num_vertices};
+    int* out_offsets = nullptr;
+    int count = s2c_edge_tessellator_project_batch(tessellator, xyz, offsets, 1, out_xy, &out_offsets);
+    free(out_offsets);
+    return count;
+}
+
+int s2c_edge_tessellator_unproject(const S2CEdgeTessellator* tessellator, const double* xy, int num_vertices, double** out_xyz) {
+    int offsets[2] = {0, num_vertices};
+    int* out_offsets = nullptr;
+    int count = s2c_edge_tessellator_unproject_batch(tessellator, xy, offsets, 1, out_xyz, &out_offsets);
+    free(out_offsets);
+    return count;
+}
+
+int s2c_edge_tessellator_project_batch(const S2CEdgeTessellator* tessellator, const double* xyz, const int* offsets,
+                                       int num_polylines, double** out_xy, int** out_offsets) {
+    if (out_xy) *out_xy = nullptr;
+    if (out_offsets) *out_offsets = nullptr;
+    if (!tessellator || !xyz || !offsets || !out_xy || !out_offsets || num_polylines <= 0) return 0;
+
+    std::vector<R2Point> vertices;
+    *out_offsets = (int*)malloc(sizeof(int) * (num_polylines + 1));
+    (*out_offsets)[0] = 0;
+    for (int i = 0; i < num_polylines; ++i) {
+        if (offsets[i + 1] > offsets[i]) {
+            append_projected_chain(tessellator, xyz, offsets[i], offsets[i + 1], &vertices);
+        }
+        (*out_offsets)[i + 1] = vertices.size();
+    }
+
+    *out_xy = (double*)malloc(sizeof(double) * 2 * std::max<size_t>(vertices.size(), 1));
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        (*out_xy)[2 * i] = vertices[i].x();
+        (*out_xy)[2 * i + 1] = vertices[i].y();
+    }
+    return vertices.size();
+}
+
+int s2c_edge_tessellator_unproject_batch(const S2CEdgeTessellator* tessellator, const double* xy, const int* offsets,
+                                         int num_polylines, double** out_xyz, int** out_offsets) {
+    if (out_xyz) *out_xyz = nullptr;
+    if (out_offsets) *out_offsets = nullptr;
+    if (!tessellator || !xy || !offsets || !out_xyz || !out_offsets || num_polylines <= 0) return 0;
+
+    std::vector<S2Point> vertices;
+    *out_offsets = (int*)malloc(sizeof(int) * (num_polylines + 1));
+    (*out_offsets)[0] = 0;
+    for (int i = 0; i < num_polylines; ++i) {
+        if (offsets[i + 1] > offsets[i]) {
+            append_unprojected_chain(tessellator, xy, offsets[i], offsets[i + 1], &vertices);
+        }
+        (*out_offsets)[i + 1] = vertices.size();
+    }
+
+    *out_xyz = (double*)malloc(sizeof(double) * 3 * std::max<size_t>(vertices.size(), 1));
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        (*out_xyz)[3 * i] = vertices[i].x();
+        (*out_xyz)[3 * i + 1] = vertices[i].y();
+        (*out_xyz)[3 * i + 2] = vertices[i].z();
+    }
+    return vertices.size();
+}
+
+// S2Polygon functions
+S2CPolygon* s2c_polygon_new(void) {
+    auto* polygon = new S2CPolygon;
+    polygon->polygon = std::make_unique<S2Polygon>();
+    return polygon;
+}
+
+S2CPolygon* s2c_polygon_new_from_loop(S2CLoop* loop) {
+    if (!loop || !loop->loop) return nullptr;
+    auto* polygon = new S2CPolygon;
+    // Transfer ownership of the loop
+    polygon->polygon = std::make_unique<S2Polygon>(std::move(loop->loop));
+    return polygon;
+}
+
+S2CPolygon* s2c_polygon_new_from_loops(S2CLoop** loops, int num_loops) {
     if (!loops || num_loops <= 0) return nullptr;
     
     std::vector<std::unique_ptr<S2Loop>> loop_vec;
@@ -1512,11 +2884,9 @@ bool s2c_polygon_is_empty(const S2CPolygon* polygon) {
 
 bool s2c_polygon_is_valid(const S2CPolygon* polygon, S2CError* error) {
     if (!polygon || !polygon->polygon) return false;
-    bool valid = polygon->polygon->IsValid();
-    if (error) {
-        error->ok = valid;
-        error->text = valid ? nullptr : copy_string("Polygon validation failed");
-    }
+    S2Error s2_error;
+    bool valid = !polygon->polygon->FindValidationError(&s2_error);
+    report_error(error, s2_error);
     return valid;
 }
 
@@ -1595,6 +2965,46 @@ void s2c_polygon_init_to_union(S2CPolygon* polygon, S2CPolygon** polygons, int n
     }
 }
 
+void s2c_polygon_init_to_intersection(S2CPolygon* polygon, const S2CPolygon* a, const S2CPolygon* b) {
+    if (!polygon || !polygon->polygon || !a || !a->polygon || !b || !b->polygon) return;
+    polygon->polygon->InitToIntersection(*a->polygon, *b->polygon);
+}
+
+// Clips each polygon against clip; out[i] is NULL for NULL inputs or when
+// cancelled before polygon i was processed.
+static int intersect_polygons(const S2CPolygon* clip, S2CPolygon** polygons, int num_polygons,
+                              S2CThreadPool* pool, const std::atomic<bool>* cancelled, S2CPolygon** out) {
+    std::atomic<int> count(0);
+    run_parallel(pool, 0, num_polygons, [&](int i) {
+        out[i] = nullptr;
+        if (is_cancelled(cancelled) || !polygons[i] || !polygons[i]->polygon) return;
+        auto* result = new S2CPolygon;
+        result->polygon = std::make_unique<S2Polygon>();
+        result->polygon->InitToIntersection(*clip->polygon, *polygons[i]->polygon);
+        out[i] = result;
+        count.fetch_add(1, std::memory_order_relaxed);
+    });
+    return count.load();
+}
+
+int s2c_polygon_intersection_batch(const S2CPolygon* clip, S2CPolygon** polygons, int num_polygons,
+                                   S2CThreadPool* pool, S2CPolygon** out) {
+    if (!clip || !clip->polygon || !polygons || !out || num_polygons <= 0) return 0;
+    return intersect_polygons(clip, polygons, num_polygons, pool, nullptr, out);
+}
+
+S2CTask* s2c_polygon_intersection_batch_async(const S2CPolygon* clip, S2CPolygon** polygons, int num_polygons,
+                                              S2CThreadPool* pool, S2CPolygon** out,
+                                              S2CTaskCallback callback, void* user_data) {
+    if (!clip || !clip->polygon || !polygons || !out || num_polygons < 0) return nullptr;
+    std::fill(out, out + num_polygons, nullptr);
+    return submit_task(pool, callback, user_data,
+                       [=](const std::atomic<bool>* cancelled, int64_t* result) {
+                           *result = intersect_polygons(clip, polygons, num_polygons, pool, cancelled, out);
+                           return !is_cancelled(cancelled);
+                       });
+}
+
 void s2c_polygon_copy(S2CPolygon* dest, const S2CPolygon* src) {
     if (!dest || !dest->polygon || !src || !src->polygon) return;
     dest->polygon->Copy(*src->polygon);
@@ -1660,14 +3070,13 @@ S2CLatLngRect* s2c_polygon_get_rect_bound(const S2CPolygon* polygon) {
 }
 
 char* s2c_polygon_encode(const S2CPolygon* polygon, size_t* length) {
-    // TODO: Implement encoding
     if (length) *length = 0;
-    return nullptr;
+    if (!polygon || !polygon->polygon || !length) return nullptr;
+    return encode_to_buffer(*polygon->polygon, length);
 }
 
 bool s2c_polygon_decode(S2CPolygon* polygon, const char* data, size_t length) {
-    // TODO: Implement decoding
-    return false;
+    return polygon && decode_into(data, length, &polygon->polygon);
 }
 
 S2CPolygon* s2c_polygon_clone(const S2CPolygon* polygon) {
@@ -1679,13 +3088,21 @@ S2CPolygon* s2c_polygon_clone(const S2CPolygon* polygon) {
 
 // S2Builder functions
 S2CBuilder* s2c_builder_new(void) {
-    return new S2CBuilder;
+    auto* builder = new S2CBuilder;
+    S2Builder::Options options;
+    options.set_memory_tracker(&builder->tracking.tracker);
+    builder->builder.Init(options);
+    return builder;
 }
 
 void s2c_builder_destroy(S2CBuilder* builder) {
     delete builder;
 }
 
+void s2c_builder_set_memory_tracker(S2CBuilder* builder, S2CMemoryTracker* tracker) {
+    if (builder) builder->tracking.Attach(tracker);
+}
+
 void s2c_builder_start_layer(S2CBuilder* builder, S2CBuilderLayer* layer) {
     if (builder && layer && layer->layer) {
         builder->builder.StartLayer(std::move(layer->layer));
@@ -1698,14 +3115,46 @@ void s2c_builder_add_edge(S2CBuilder* builder, const S2CPoint* v0, const S2CPoin
     }
 }
 
+void s2c_builder_add_edges(S2CBuilder* builder, const double* xyz, const int* chain_offsets, int num_chains) {
+    if (!builder || !xyz || !chain_offsets || num_chains <= 0) return;
+    for (int i = 0; i < num_chains; ++i) {
+        for (int j = chain_offsets[i]; j + 1 < chain_offsets[i + 1]; ++j) {
+            builder->builder.AddEdge(xyz_point(xyz, j), xyz_point(xyz, j + 1));
+        }
+    }
+}
+
+void s2c_builder_add_loops(S2CBuilder* builder, const double* xyz, const int* loop_offsets, int num_loops) {
+    if (!builder || !xyz || !loop_offsets || num_loops <= 0) return;
+    for (int i = 0; i < num_loops; ++i) {
+        int begin = loop_offsets[i];
+        int end = loop_offsets[i + 1];
+        if (end - begin < 2) continue;
+        for (int j = begin; j < end; ++j) {
+            int next = (j + 1 < end) ? j + 1 : begin;
+            builder->builder.AddEdge(xyz_point(xyz, j), xyz_point(xyz, next));
+        }
+    }
+}
+
 bool s2c_builder_build(S2CBuilder* builder, S2CError* error) {
+    return s2c_builder_build_cancellable(builder, nullptr, error);
+}
+
+// Fails with S2C_ERROR_CANCELLED without starting if token has already expired
+static bool check_cancel_token(const S2CCancelToken* token, S2CError* error) {
+    if (!cancel_token_expired(token)) return true;
+    report_error(error, S2C_ERROR_CANCELLED, "Operation cancelled");
+    return false;
+}
+
+bool s2c_builder_build_cancellable(S2CBuilder* builder, const S2CCancelToken* token, S2CError* error) {
     if (!builder) return false;
+    if (!check_cancel_token(token, error)) return false;
+    ScopedOperation scoped(&builder->tracking, token);
     S2Error s2_error;
     bool result = builder->builder.Build(&s2_error);
-    if (error) {
-        error->ok = s2_error.ok();
-        error->text = copy_string(s2_error.text());
-    }
+    report_error(error, s2_error);
     return result;
 }
 
@@ -1730,6 +3179,140 @@ S2CBuilderLayer* s2c_polygon_layer_as_builder_layer(S2CPolygonLayer* layer) {
     return builder_layer;
 }
 
+// S2GraphLayer functions
+namespace {
+
+// Builder layer that flattens each output graph into contiguous buffers and
+// hands them to a C callback, so no intermediate geometry is materialized.
+class GraphCallbackLayer : public S2Builder::Layer {
+  public:
+    GraphCallbackLayer(S2CGraphCallback callback, void* user_data,
+                       const S2Builder::GraphOptions& graph_options)
+        : callback_(callback), user_data_(user_data), graph_options_(graph_options) {}
+
+    S2Builder::GraphOptions graph_options() const override {
+        return graph_options_;
+    }
+
+    void Build(const S2Builder::Graph& g, S2Error* error) override {
+        vertices_.clear();
+        vertices_.reserve(3 * g.num_vertices());
+        for (const S2Point& v : g.vertices()) {
+            vertices_.push_back(v.x());
+            vertices_.push_back(v.y());
+            vertices_.push_back(v.z());
+        }
+
+        edges_.clear();
+        edges_.reserve(2 * g.num_edges());
+        input_edge_offsets_.clear();
+        input_edge_offsets_.reserve(g.num_edges() + 1);
+        input_edge_ids_.clear();
+        for (S2Builder::Graph::EdgeId e = 0; e < g.num_edges(); ++e) {
+            edges_.push_back(g.edge(e).first);
+            edges_.push_back(g.edge(e).second);
+            input_edge_offsets_.push_back(input_edge_ids_.size());
+            for (int32_t id : g.input_edge_ids(e)) {
+                input_edge_ids_.push_back(id);
+            }
+        }
+        input_edge_offsets_.push_back(input_edge_ids_.size());
+
+        if (!callback_(vertices_.data(), g.num_vertices(),
+                       edges_.data(), g.num_edges(),
+                       input_edge_offsets_.data(), input_edge_ids_.data(),
+                       user_data_)) {
+            error->Init(S2Error::FAILED_PRECONDITION, "Graph callback rejected the output");
+        }
+    }
+
+  private:
+    S2CGraphCallback callback_;
+    void* user_data_;
+    S2Builder::GraphOptions graph_options_;
+    std::vector<double> vertices_;
+    std::vector<int32_t> edges_;
+    std::vector<int32_t> input_edge_offsets_;
+    std::vector<int32_t> input_edge_ids_;
+};
+
+}  // namespace
+
+struct S2CGraphLayer { GraphCallbackLayer* layer; };
+
+S2CGraphLayer* s2c_graph_layer_new(S2CGraphCallback callback, void* user_data) {
+    if (!callback) return nullptr;
+    auto* layer = new S2CGraphLayer;
+    layer->layer = new GraphCallbackLayer(callback, user_data, S2Builder::GraphOptions());
+    return layer;
+}
+
+S2CGraphLayer* s2c_graph_layer_new_with_options(S2CGraphCallback callback, void* user_data,
+                                                S2CEdgeType edge_type,
+                                                S2CDegenerateEdges degenerate_edges,
+                                                S2CDuplicateEdges duplicate_edges,
+                                                S2CSiblingPairs sibling_pairs) {
+    if (!callback) return nullptr;
+    using GraphOptions = S2Builder::GraphOptions;
+
+    S2Builder::EdgeType s2_edge_type = edge_type == S2C_EDGE_TYPE_UNDIRECTED ?
+        S2Builder::EdgeType::UNDIRECTED : S2Builder::EdgeType::DIRECTED;
+
+    GraphOptions::DegenerateEdges s2_degenerate_edges;
+    switch (degenerate_edges) {
+        case S2C_DEGENERATE_EDGES_DISCARD:
+            s2_degenerate_edges = GraphOptions::DegenerateEdges::DISCARD;
+            break;
+        case S2C_DEGENERATE_EDGES_DISCARD_EXCESS:
+            s2_degenerate_edges = GraphOptions::DegenerateEdges::DISCARD_EXCESS;
+            break;
+        default:
+            s2_degenerate_edges = GraphOptions::DegenerateEdges::KEEP;
+    }
+
+    GraphOptions::DuplicateEdges s2_duplicate_edges = duplicate_edges == S2C_DUPLICATE_EDGES_MERGE ?
+        GraphOptions::DuplicateEdges::MERGE : GraphOptions::DuplicateEdges::KEEP;
+
+    GraphOptions::SiblingPairs s2_sibling_pairs;
+    switch (sibling_pairs) {
+        case S2C_SIBLING_PAIRS_DISCARD:
+            s2_sibling_pairs = GraphOptions::SiblingPairs::DISCARD;
+            break;
+        case S2C_SIBLING_PAIRS_DISCARD_EXCESS:
+            s2_sibling_pairs = GraphOptions::SiblingPairs::DISCARD_EXCESS;
+            break;
+        case S2C_SIBLING_PAIRS_REQUIRE:
+            s2_sibling_pairs = GraphOptions::SiblingPairs::REQUIRE;
+            break;
+        case S2C_SIBLING_PAIRS_CREATE:
+            s2_sibling_pairs = GraphOptions::SiblingPairs::CREATE;
+            break;
+        default:
+            s2_sibling_pairs = GraphOptions::SiblingPairs::KEEP;
+    }
+
+    auto* layer = new S2CGraphLayer;
+    layer->layer = new GraphCallbackLayer(
+        callback, user_data,
+        GraphOptions(s2_edge_type, s2_degenerate_edges, s2_duplicate_edges, s2_sibling_pairs));
+    return layer;
+}
+
+void s2c_graph_layer_destroy(S2CGraphLayer* layer) {
+    if (layer) {
+        delete layer->layer;
+        delete layer;
+    }
+}
+
+S2CBuilderLayer* s2c_graph_layer_as_builder_layer(S2CGraphLayer* layer) {
+    if (!layer || !layer->layer) return nullptr;
+    auto* builder_layer = new S2CBuilderLayer;
+    builder_layer->layer = std::unique_ptr<S2Builder::Layer>(layer->layer);
+    layer->layer = nullptr; // Transfer ownership
+    return builder_layer;
+}
+
 // Additional S2Cap constructor
 S2CCap* s2c_cap_from_center_angle(const S2CPoint* center, const S1CAngle* angle) {
     if (!center || !angle) return nullptr;
@@ -1771,7 +3354,9 @@ S2CBooleanOperation* s2c_boolean_operation_new(S2CBooleanOpType op_type, S2CBuil
     }
     
     auto* op = new S2CBooleanOperation;
-    op->op = std::make_unique<S2BooleanOperation>(s2_op_type, std::move(layer->layer));
+    S2BooleanOperation::Options options;
+    options.set_memory_tracker(&op->tracking.tracker);
+    op->op = std::make_unique<S2BooleanOperation>(s2_op_type, std::move(layer->layer), options);
     return op;
 }
 
@@ -1779,13 +3364,14 @@ void s2c_boolean_operation_destroy(S2CBooleanOperation* op) {
     delete op;
 }
 
+void s2c_boolean_operation_set_memory_tracker(S2CBooleanOperation* op, S2CMemoryTracker* tracker) {
+    if (op) op->tracking.Attach(tracker);
+}
+
 bool s2c_boolean_operation_build(S2CBooleanOperation* op, S2CError* error) {
     if (!op || !op->op) return false;
     // This version requires shape indexes to be added via Build method
-    if (error) {
-        error->ok = false;
-        error->text = copy_string("Use s2c_boolean_operation_build_indexes instead");
-    }
+    report_error(error, S2C_ERROR_FAILED_PRECONDITION, "Use s2c_boolean_operation_build_indexes instead");
     return false;
 }
 
@@ -1869,100 +3455,359 @@ S2CBooleanOperation* s2c_boolean_operation_new_with_options(S2CBooleanOpType op_
     }
     
     auto* boolean_op = new S2CBooleanOperation;
-    if (options) {
-        boolean_op->op = std::make_unique<S2BooleanOperation>(
-            s2_op_type, std::move(layer->layer), options->options);
-    } else {
-        boolean_op->op = std::make_unique<S2BooleanOperation>(
-            s2_op_type, std::move(layer->layer));
-    }
+    S2BooleanOperation::Options s2_options = options ? options->options : S2BooleanOperation::Options();
+    s2_options.set_memory_tracker(&boolean_op->tracking.tracker);
+    boolean_op->op = std::make_unique<S2BooleanOperation>(
+        s2_op_type, std::move(layer->layer), s2_options);
     return boolean_op;
 }
 
 // Build boolean operation with shape indexes
 bool s2c_boolean_operation_build_indexes(S2CBooleanOperation* op, const S2CShapeIndex* a, const S2CShapeIndex* b, S2CError* error) {
+    return s2c_boolean_operation_build_indexes_cancellable(op, a, b, nullptr, error);
+}
+
+bool s2c_boolean_operation_build_mutable_indexes(S2CBooleanOperation* op, const S2CMutableShapeIndex* a, const S2CMutableShapeIndex* b, S2CError* error) {
+    return s2c_boolean_operation_build_mutable_indexes_cancellable(op, a, b, nullptr, error);
+}
+
+static bool build_boolean_operation(S2CBooleanOperation* op, const MutableS2ShapeIndex& a, const MutableS2ShapeIndex& b,
+                                    const S2CCancelToken* token, S2CError* error) {
+    if (!check_cancel_token(token, error)) return false;
+    ScopedOperation scoped(&op->tracking, token);
+    S2Error s2_error;
+    bool result = op->op->Build(a, b, &s2_error);
+    report_error(error, s2_error);
+    return result;
+}
+
+bool s2c_boolean_operation_build_indexes_cancellable(S2CBooleanOperation* op, const S2CShapeIndex* a, const S2CShapeIndex* b,
+                                                     const S2CCancelToken* token, S2CError* error) {
     if (!op || !op->op || !a || !b) {
-        if (error) {
-            error->ok = false;
-            error->text = copy_string("Invalid parameters for boolean operation build");
-        }
+        report_error(error, S2C_ERROR_INVALID_ARGUMENT, "Invalid parameters for boolean operation build");
         return false;
     }
-    
-    S2Error s2_error;
-    bool result = op->op->Build(a->index, b->index, &s2_error);
-    
-    if (error) {
-        error->ok = s2_error.ok();
-        error->text = copy_string(s2_error.text().c_str());
+    return build_boolean_operation(op, a->index, b->index, token, error);
+}
+
+bool s2c_boolean_operation_build_mutable_indexes_cancellable(S2CBooleanOperation* op, const S2CMutableShapeIndex* a,
+                                                             const S2CMutableShapeIndex* b, const S2CCancelToken* token,
+                                                             S2CError* error) {
+    if (!op || !op->op || !a || !b) {
+        report_error(error, S2C_ERROR_INVALID_ARGUMENT, "Invalid parameters for boolean operation build");
+        return false;
     }
-    
+    return build_boolean_operation(op, a->index, b->index, token, error);
+}
+
+// S2BufferOperation functions
+static S2CBufferOperation* new_buffer_operation(S2CBuilderLayer* layer, S2BufferOperation::Options options) {
+    if (!layer || !layer->layer) return nullptr;
+    auto* op = new S2CBufferOperation;
+    options.set_memory_tracker(&op->tracking.tracker);
+    op->op = std::make_unique<S2BufferOperation>(std::move(layer->layer), options);
+    return op;
+}
+
+S2CBufferOperation* s2c_buffer_operation_new(S2CBuilderLayer* layer) {
+    return new_buffer_operation(layer, S2BufferOperation::Options());
+}
+
+S2CBufferOperation* s2c_buffer_operation_new_with_options(S2CBuilderLayer* layer, S1CAngle* buffer_radius, double error_fraction) {
+    S2BufferOperation::Options options(buffer_radius ? buffer_radius->angle : S1Angle::Zero());
+    options.set_error_fraction(error_fraction);
+    return new_buffer_operation(layer, options);
+}
+
+void s2c_buffer_operation_destroy(S2CBufferOperation* op) {
+    delete op;
+}
+
+void s2c_buffer_operation_set_memory_tracker(S2CBufferOperation* op, S2CMemoryTracker* tracker) {
+    if (op) op->tracking.Attach(tracker);
+}
+
+void s2c_buffer_operation_add_polygon(S2CBufferOperation* op, S2CPolygon* polygon) {
+    if (op && op->op && polygon && polygon->polygon) {
+        op->op->AddShape(S2Polygon::Shape(polygon->polygon.get()));
+    }
+}
+
+void s2c_buffer_operation_add_point(S2CBufferOperation* op, const S2CPoint* point) {
+    if (op && op->op && point) {
+        op->op->AddPoint(point->point);
+    }
+}
+
+bool s2c_buffer_operation_build(S2CBufferOperation* op, S2CError* error) {
+    return s2c_buffer_operation_build_cancellable(op, nullptr, error);
+}
+
+bool s2c_buffer_operation_build_cancellable(S2CBufferOperation* op, const S2CCancelToken* token, S2CError* error) {
+    if (!op || !op->op) {
+        report_error(error, S2C_ERROR_INVALID_ARGUMENT, "Invalid parameters for buffer operation build");
+        return false;
+    }
+    if (!check_cancel_token(token, error)) return false;
+    ScopedOperation scoped(&op->tracking, token);
+    S2Error s2_error;
+    bool result = op->op->Build(&s2_error);
+    report_error(error, s2_error);
     return result;
 }
 
-bool s2c_boolean_operation_build_mutable_indexes(S2CBooleanOperation* op, const S2CMutableShapeIndex* a, const S2CMutableShapeIndex* b, S2CError* error) {
-    if (!op || !op->op || !a || !b) {
-        if (error) {
-            error->ok = false;
-            error->text = copy_string("Invalid parameters for boolean operation build");
+// S2WindingOperation functions
+S2CWindingOperation* s2c_winding_operation_new(S2CBuilderLayer* layer) {
+    if (!layer || !layer->layer) return nullptr;
+    auto* op = new S2CWindingOperation;
+    op->op = std::make_unique<S2WindingOperation>(std::move(layer->layer));
+    return op;
+}
+
+S2CWindingOperation* s2c_winding_operation_new_with_snap_level(S2CBuilderLayer* layer, int snap_level) {
+    if (!layer || !layer->layer || snap_level < 0 || snap_level > 30) return nullptr;
+    S2WindingOperation::Options options;
+    options.set_snap_function(s2builderutil::S2CellIdSnapFunction(snap_level));
+    auto* op = new S2CWindingOperation;
+    op->op = std::make_unique<S2WindingOperation>(std::move(layer->layer), options);
+    return op;
+}
+
+void s2c_winding_operation_destroy(S2CWindingOperation* op) {
+    delete op;
+}
+
+void s2c_winding_operation_add_loop(S2CWindingOperation* op, const S2CLoop* loop) {
+    if (!op || !op->op || !loop || !loop->loop || loop->loop->is_empty_or_full()) return;
+    std::vector<S2Point> vertices;
+    vertices.reserve(loop->loop->num_vertices());
+    for (int i = 0; i < loop->loop->num_vertices(); ++i) {
+        vertices.push_back(loop->loop->vertex(i));
+    }
+    op->op->AddLoop(vertices);
+}
+
+void s2c_winding_operation_add_loops(S2CWindingOperation* op, const double* xyz, const int* loop_offsets, int num_loops) {
+    if (!op || !op->op || !xyz || !loop_offsets || num_loops <= 0) return;
+    std::vector<S2Point> vertices;
+    for (int i = 0; i < num_loops; ++i) {
+        vertices.clear();
+        for (int j = loop_offsets[i]; j < loop_offsets[i + 1]; ++j) {
+            vertices.push_back(xyz_point(xyz, j));
+        }
+        if (!vertices.empty()) {
+            op->op->AddLoop(vertices);
         }
+    }
+}
+
+void s2c_winding_operation_add_mutable_index(S2CWindingOperation* op, const S2CMutableShapeIndex* index) {
+    if (!op || !op->op || !index) return;
+    std::vector<S2Point> vertices;
+    for (int i = 0; i < index->index.num_shape_ids(); ++i) {
+        const S2Shape* shape = index->index.shape(i);
+        if (!shape || shape->dimension() != 2) continue;
+        for (int c = 0; c < shape->num_chains(); ++c) {
+            S2Shape::Chain chain = shape->chain(c);
+            vertices.clear();
+            for (int e = 0; e < chain.length; ++e) {
+                vertices.push_back(shape->chain_edge(c, e).v0);
+            }
+            if (!vertices.empty()) {
+                op->op->AddLoop(vertices);
+            }
+        }
+    }
+}
+
+bool s2c_winding_operation_build(S2CWindingOperation* op, const S2CPoint* ref_point, int ref_winding,
+                                 S2CWindingRule rule, S2CError* error) {
+    if (!op || !op->op) {
+        report_error(error, S2C_ERROR_INVALID_ARGUMENT, "Invalid parameters for winding operation build");
         return false;
     }
-    
-    S2Error s2_error;
-    bool result = op->op->Build(a->index, b->index, &s2_error);
-    
-    if (error) {
-        error->ok = s2_error.ok();
-        error->text = copy_string(s2_error.text().c_str());
+
+    S2WindingOperation::WindingRule s2_rule;
+    switch (rule) {
+        case S2C_WINDING_RULE_POSITIVE:
+            s2_rule = S2WindingOperation::WindingRule::POSITIVE;
+            break;
+        case S2C_WINDING_RULE_NEGATIVE:
+            s2_rule = S2WindingOperation::WindingRule::NEGATIVE;
+            break;
+        case S2C_WINDING_RULE_ODD:
+            s2_rule = S2WindingOperation::WindingRule::ODD;
+            break;
+        default:
+            s2_rule = S2WindingOperation::WindingRule::NON_ZERO;
     }
-    
+
+    S2Point ref_p = ref_point ? ref_point->point : S2::Origin();
+    S2Error s2_error;
+    bool result = op->op->Build(ref_p, ref_winding, s2_rule, &s2_error);
+    report_error(error, s2_error);
+
     return result;
 }
 
+// S2ConvexHullQuery functions
+S2CConvexHullQuery* s2c_convex_hull_query_new(void) {
+    return new S2CConvexHullQuery;
+}
+
+void s2c_convex_hull_query_destroy(S2CConvexHullQuery* query) {
+    delete query;
+}
+
+void s2c_convex_hull_query_add_point(S2CConvexHullQuery* query, const S2CPoint* point) {
+    if (query && point) {
+        query->query.AddPoint(point->point);
+    }
+}
+
+void s2c_convex_hull_query_add_points(S2CConvexHullQuery* query, const double* xyz, size_t num_points) {
+    if (!query || !xyz) return;
+    for (size_t i = 0; i < num_points; ++i) {
+        query->query.AddPoint(xyz_point(xyz, i));
+    }
+}
+
+void s2c_convex_hull_query_add_polyline(S2CConvexHullQuery* query, const S2CPolyline* polyline) {
+    if (query && polyline && polyline->polyline) {
+        query->query.AddPolyline(*polyline->polyline);
+    }
+}
+
+void s2c_convex_hull_query_add_loop(S2CConvexHullQuery* query, const S2CLoop* loop) {
+    if (query && loop && loop->loop) {
+        query->query.AddLoop(*loop->loop);
+    }
+}
+
+void s2c_convex_hull_query_add_polygon(S2CConvexHullQuery* query, const S2CPolygon* polygon) {
+    if (query && polygon && polygon->polygon) {
+        query->query.AddPolygon(*polygon->polygon);
+    }
+}
+
+S2CCap* s2c_convex_hull_query_get_cap_bound(S2CConvexHullQuery* query) {
+    if (!query) return nullptr;
+    auto* cap = new S2CCap;
+    cap->cap = query->query.GetCapBound();
+    return cap;
+}
+
+S2CLoop* s2c_convex_hull_query_get_convex_hull(S2CConvexHullQuery* query) {
+    if (!query) return nullptr;
+    auto* loop = new S2CLoop;
+    loop->loop = query->query.GetConvexHull();
+    return loop;
+}
+
+int s2c_convex_hull_batch(const double* xyz, const int64_t* group_ids, size_t num_points,
+                          S2CLoop*** hulls, int64_t** hull_group_ids) {
+    if (!xyz || !group_ids || !hulls || num_points == 0) {
+        if (hulls) *hulls = nullptr;
+        if (hull_group_ids) *hull_group_ids = nullptr;
+        return 0;
+    }
+
+    std::vector<S2CLoop*> results;
+    std::vector<int64_t> result_ids;
+    size_t begin = 0;
+    while (begin < num_points) {
+        size_t end = begin + 1;
+        while (end < num_points && group_ids[end] == group_ids[begin]) ++end;
+
+        S2ConvexHullQuery query;
+        for (size_t i = begin; i < end; ++i) {
+            query.AddPoint(xyz_point(xyz, i));
+        }
+        auto* loop = new S2CLoop;
+        loop->loop = query.GetConvexHull();
+        results.push_back(loop);
+        result_ids.push_back(group_ids[begin]);
+        begin = end;
+    }
+
+    *hulls = (S2CLoop**)malloc(sizeof(S2CLoop*) * results.size());
+    std::copy(results.begin(), results.end(), *hulls);
+    if (hull_group_ids) {
+        *hull_group_ids = (int64_t*)malloc(sizeof(int64_t) * result_ids.size());
+        std::copy(result_ids.begin(), result_ids.end(), *hull_group_ids);
+    }
+    return results.size();
+}
+
 // S2MutableShapeIndex functions
+// Bumped on every destroy; threads holding cached queries purge on change
+static std::atomic<uint64_t> index_destroy_generation{0};
+
 S2CMutableShapeIndex* s2c_mutable_shape_index_new(void) {
     return new S2CMutableShapeIndex;
 }
 
 void s2c_mutable_shape_index_destroy(S2CMutableShapeIndex* index) {
+    if (!index) return;
     delete index;
+    index_destroy_generation.fetch_add(1, std::memory_order_release);
+}
+
+// Runs a call that may grow, build or shrink index. With a budget attached
+// the usage change is forwarded to it even when S2 allocated less than
+// kTrackerCallbackBytes, and a build that ran out of budget (during this
+// call or an earlier lazy build) is recorded in the thread's last error and
+// returned.
+template <typename Update>
+static S2Error update_tracked_index(S2CMutableShapeIndex* index, Update update) {
+    if (!index->tracking.budget) {
+        update();
+        return S2Error();
+    }
+    S2Error s2_error;
+    {
+        ScopedOperation scoped(&index->tracking, nullptr);
+        update();
+        s2_error = index->tracking.tracker.error();
+    }
+    report_error(nullptr, s2_error);
+    return s2_error;
 }
 
 void s2c_mutable_shape_index_add_polygon(S2CMutableShapeIndex* index, S2CPolygon* polygon) {
-    if (index && polygon && polygon->polygon) {
+    if (index && !index->frozen.load(std::memory_order_acquire) && polygon && polygon->polygon) {
         auto shape = std::make_unique<S2Polygon::OwningShape>(
             std::unique_ptr<S2Polygon>(polygon->polygon->Clone())
         );
-        index->index.Add(std::move(shape));
+        update_tracked_index(index, [&] { index->index.Add(std::move(shape)); });
     }
 }
 
 void s2c_mutable_shape_index_add_polyline(S2CMutableShapeIndex* index, S2CPolyline* polyline) {
-    if (index && polyline && polyline->polyline) {
+    if (index && !index->frozen.load(std::memory_order_acquire) && polyline && polyline->polyline) {
         std::vector<S2Point> points;
         for (int i = 0; i < polyline->polyline->num_vertices(); i++) {
             points.push_back(polyline->polyline->vertex(i));
         }
         auto shape = std::make_unique<S2LaxPolylineShape>(points);
-        index->index.Add(std::move(shape));
+        update_tracked_index(index, [&] { index->index.Add(std::move(shape)); });
     }
 }
 
 void s2c_mutable_shape_index_add_point(S2CMutableShapeIndex* index, const S2CPoint* point) {
-    if (index && point) {
+    if (index && !index->frozen.load(std::memory_order_acquire) && point) {
         std::vector<S2Point> points = {point->point};
         auto shape = std::make_unique<S2PointVectorShape>(points);
-        index->index.Add(std::move(shape));
+        update_tracked_index(index, [&] { index->index.Add(std::move(shape)); });
     }
 }
 
 void s2c_mutable_shape_index_add_loop(S2CMutableShapeIndex* index, S2CLoop* loop) {
-    if (index && loop && loop->loop) {
+    if (index && !index->frozen.load(std::memory_order_acquire) && loop && loop->loop) {
         auto shape = std::make_unique<S2Loop::OwningShape>(
             std::unique_ptr<S2Loop>(loop->loop->Clone())
         );
-        index->index.Add(std::move(shape));
+        update_tracked_index(index, [&] { index->index.Add(std::move(shape)); });
     }
 }
 
@@ -1981,15 +3826,49 @@ int s2c_mutable_shape_index_num_edges(const S2CMutableShapeIndex* index) {
 }
 
 void s2c_mutable_shape_index_minimize(S2CMutableShapeIndex* index) {
-    if (index) {
-        index->index.Minimize();
+    // Minimizing a frozen index would force a lazy rebuild under concurrent readers
+    if (index && !index->frozen.load(std::memory_order_acquire)) {
+        update_tracked_index(index, [index] { index->index.Minimize(); });
     }
 }
 
 void s2c_mutable_shape_index_force_build(S2CMutableShapeIndex* index) {
     if (index) {
+        update_tracked_index(index, [index] { index->index.ForceBuild(); });
+    }
+}
+
+void s2c_mutable_shape_index_set_memory_tracker(S2CMutableShapeIndex* index, S2CMemoryTracker* tracker) {
+    if (!index) return;
+    // Re-attaching makes S2 tally the index's current size against the new budget
+    index->index.set_memory_tracker(nullptr);
+    index->tracking.Attach(tracker);
+    if (tracker) {
+        index->index.set_memory_tracker(&index->tracking.tracker);
+        index->tracking.Check();
+    }
+}
+
+int64_t s2c_mutable_shape_index_space_used(const S2CMutableShapeIndex* index) {
+    return index ? static_cast<int64_t>(index->index.SpaceUsed()) : 0;
+}
+
+bool s2c_mutable_shape_index_force_build_cancellable(S2CMutableShapeIndex* index, const S2CCancelToken* token,
+                                                     S2CError* error) {
+    if (!index) return false;
+    if (!check_cancel_token(token, error)) return false;
+    // Without a budget the tracker is only attached for the build itself
+    bool attach = !index->tracking.budget;
+    if (attach) index->index.set_memory_tracker(&index->tracking.tracker);
+    S2Error s2_error;
+    {
+        ScopedOperation scoped(&index->tracking, token);
         index->index.ForceBuild();
+        s2_error = index->tracking.tracker.error();
     }
+    if (attach) index->index.set_memory_tracker(nullptr);
+    report_error(error, s2_error);
+    return s2_error.ok();
 }
 
 S2CShapeIndex* s2c_mutable_shape_index_snapshot(const S2CMutableShapeIndex* index) {
@@ -2356,6 +4235,236 @@ S2CPoint* s2c_crossing_edge_pair_b(const S2CCrossingEdgePair* pair) {
     return new S2CPoint{pair->b};
 }
 
+// Frozen indexes and per-thread queries
+void s2c_mutable_shape_index_freeze(S2CMutableShapeIndex* index) {
+    if (!index) return;
+    std::call_once(index->freeze_once, [index] {
+        update_tracked_index(index, [index] { index->index.ForceBuild(); });
+        index->frozen.store(true, std::memory_order_release);
+    });
+}
+
+bool s2c_mutable_shape_index_is_frozen(const S2CMutableShapeIndex* index) {
+    return index && index->frozen.load(std::memory_order_acquire);
+}
+
+// Queries owned by the calling thread for one frozen index, created on first use
+struct ThreadLocalQueries {
+    std::weak_ptr<const bool> alive;
+    std::unique_ptr<S2CContainsPointQuery> contains;
+    std::unique_ptr<S2CClosestEdgeQuery> closest_edge;
+    std::unique_ptr<S2CCrossingEdgeQuery> crossing_edge;
+};
+
+struct ThreadLocalQueryCache {
+    std::unordered_map<const S2CMutableShapeIndex*, ThreadLocalQueries> entries;
+    uint64_t generation = 0;  // index_destroy_generation at the last purge
+};
+
+static ThreadLocalQueryCache& thread_local_queries() {
+    thread_local ThreadLocalQueryCache cache;
+    return cache;
+}
+
+static ThreadLocalQueries* thread_local_queries_for(const S2CMutableShapeIndex* index) {
+    if (!s2c_mutable_shape_index_is_frozen(index)) return nullptr;
+    ThreadLocalQueryCache& cache = thread_local_queries();
+    // Drop entries for indexes destroyed since the last lookup, so threads
+    // that never call release do not accumulate them
+    uint64_t generation = index_destroy_generation.load(std::memory_order_acquire);
+    if (generation != cache.generation) {
+        cache.generation = generation;
+        for (auto it = cache.entries.begin(); it != cache.entries.end();) {
+            it = it->second.alive.expired() ? cache.entries.erase(it) : std::next(it);
+        }
+    }
+    ThreadLocalQueries& entry = cache.entries[index];
+    if (entry.alive.expired()) {
+        // First use on this thread, or a destroyed index's address was reused
+        entry = ThreadLocalQueries();
+        entry.alive = index->alive;
+    }
+    return &entry;
+}
+
+S2CContainsPointQuery* s2c_index_thread_local_contains_query(const S2CMutableShapeIndex* index) {
+    ThreadLocalQueries* entry = thread_local_queries_for(index);
+    if (!entry) return nullptr;
+    if (!entry->contains) entry->contains.reset(s2c_contains_point_query_new_mutable(index));
+    return entry->contains.get();
+}
+
+S2CClosestEdgeQuery* s2c_index_thread_local_closest_edge_query(const S2CMutableShapeIndex* index) {
+    ThreadLocalQueries* entry = thread_local_queries_for(index);
+    if (!entry) return nullptr;
+    if (!entry->closest_edge) entry->closest_edge.reset(s2c_closest_edge_query_new_mutable(index));
+    return entry->closest_edge.get();
+}
+
+S2CCrossingEdgeQuery* s2c_index_thread_local_crossing_edge_query(const S2CMutableShapeIndex* index) {
+    ThreadLocalQueries* entry = thread_local_queries_for(index);
+    if (!entry) return nullptr;
+    if (!entry->crossing_edge) entry->crossing_edge.reset(s2c_crossing_edge_query_new_mutable(index));
+    return entry->crossing_edge.get();
+}
+
+void s2c_index_thread_local_release(const S2CMutableShapeIndex* index) {
+    thread_local_queries().entries.erase(index);
+}
+
+// S2CThreadPool functions
+S2CThreadPool* s2c_thread_pool_new(int num_threads, bool pin_threads) {
+    return thread_pool_start(num_threads, pin_threads);
+}
+
+void s2c_thread_pool_destroy(S2CThreadPool* pool) {
+    if (!pool || pool == default_thread_pool()) return;
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->stopping = true;
+    }
+    pool->job_ready.notify_all();
+    for (auto& worker : pool->workers) {
+        worker.join();
+    }
+    delete pool;
+}
+
+int s2c_thread_pool_num_threads(const S2CThreadPool* pool) {
+    return pool ? static_cast<int>(pool->workers.size()) : 0;
+}
+
+S2CThreadPool* s2c_thread_pool_default(void) {
+    return default_thread_pool();
+}
+
+// S2CTask functions
+S2CTaskStatus s2c_task_poll(const S2CTask* task) {
+    if (!task) return S2C_TASK_CANCELLED;
+    std::lock_guard<std::mutex> lock(task->state->mutex);
+    return task->state->status;
+}
+
+S2CTaskStatus s2c_task_wait(S2CTask* task, int64_t timeout_ms) {
+    if (!task) return S2C_TASK_CANCELLED;
+    TaskState* state = task->state.get();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    auto finished = [state] {
+        return state->status == S2C_TASK_DONE || state->status == S2C_TASK_CANCELLED;
+    };
+    if (timeout_ms < 0) {
+        state->changed.wait(lock, finished);
+    } else {
+        state->changed.wait_for(lock, std::chrono::milliseconds(timeout_ms), finished);
+    }
+    return state->status;
+}
+
+bool s2c_task_cancel(S2CTask* task) {
+    if (!task) return false;
+    std::lock_guard<std::mutex> lock(task->state->mutex);
+    task->state->cancelled.store(true, std::memory_order_relaxed);
+    return task->state->status == S2C_TASK_PENDING || task->state->status == S2C_TASK_RUNNING;
+}
+
+int64_t s2c_task_result(const S2CTask* task) {
+    if (!task) return 0;
+    std::lock_guard<std::mutex> lock(task->state->mutex);
+    return task->state->result;
+}
+
+void s2c_task_destroy(S2CTask* task) {
+    if (!task) return;
+    TaskState* state = task->state.get();
+    if (current_callback_task != task) {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->cancelled.store(true, std::memory_order_relaxed);
+        if (state->status == S2C_TASK_PENDING) {
+            // Never started, so nothing to wait for: the queued job frees the
+            // handle and skips the work and callback
+            state->detached = true;
+            return;
+        }
+        state->changed.wait(lock, [state] { return state->callback_done; });
+    }
+    delete task;
+}
+
+S2CTask* s2c_mutable_shape_index_force_build_async(S2CMutableShapeIndex* index, S2CThreadPool* pool,
+                                                   S2CTaskCallback callback, void* user_data) {
+    if (!index) return nullptr;
+    return submit_task(pool, callback, user_data, [index](const std::atomic<bool>*, int64_t* result) {
+        S2Error s2_error = update_tracked_index(index, [index] { index->index.ForceBuild(); });
+        *result = s2_error.ok() ? index->index.num_shape_ids() : -static_cast<int64_t>(s2_error.code());
+        return true;
+    });
+}
+
+// Batch point queries. Points are visited in S2CellId order, kPointQueryChunk
+// at a time, so neighbouring points share a thread and its cached index cells.
+static const size_t kPointQueryChunk = 512;
+
+// Returns false if cancelled is set before every chunk has run.
+static bool run_point_chunks(const double* xyz, size_t n, S2CThreadPool* pool,
+                             const std::atomic<bool>* cancelled,
+                             const std::function<void(const uint32_t*, size_t)>& chunk) {
+    std::vector<uint32_t> order(n);
+    sort_points_by_cellid(xyz, n, order.data(), nullptr);
+    int num_chunks = (n + kPointQueryChunk - 1) / kPointQueryChunk;
+    run_parallel(pool, 0, num_chunks, [&](int c) {
+        if (is_cancelled(cancelled)) return;
+        size_t begin = c * kPointQueryChunk;
+        chunk(&order[begin], std::min(n, begin + kPointQueryChunk) - begin);
+    });
+    return !is_cancelled(cancelled);
+}
+
+static bool contains_points(const S2CMutableShapeIndex* index, const double* xyz, size_t n,
+                            S2CThreadPool* pool, const std::atomic<bool>* cancelled, uint8_t* out) {
+    return run_point_chunks(xyz, n, pool, cancelled, [&](const uint32_t* points, size_t count) {
+        S2ContainsPointQuery<MutableS2ShapeIndex> query(&index->index);
+        for (size_t i = 0; i < count; ++i) {
+            out[points[i]] = query.Contains(xyz_point(xyz, points[i]));
+        }
+    });
+}
+
+bool s2c_contains_point_query_batch(const S2CMutableShapeIndex* index, const double* xyz, size_t n,
+                                    S2CThreadPool* pool, uint8_t* out) {
+    if (!index || n > UINT32_MAX || (n > 0 && (!xyz || !out))) return false;
+    return contains_points(index, xyz, n, pool, nullptr, out);
+}
+
+S2CTask* s2c_contains_point_query_batch_async(const S2CMutableShapeIndex* index, const double* xyz, size_t n,
+                                              S2CThreadPool* pool, uint8_t* out,
+                                              S2CTaskCallback callback, void* user_data) {
+    if (!index || n > UINT32_MAX || (n > 0 && (!xyz || !out))) return nullptr;
+    return submit_task(pool, callback, user_data,
+                       [=](const std::atomic<bool>* cancelled, int64_t* result) {
+                           if (!contains_points(index, xyz, n, pool, cancelled, out)) return false;
+                           *result = std::count(out, out + n, 1);
+                           return true;
+                       });
+}
+
+bool s2c_closest_edge_query_batch(const S2CMutableShapeIndex* index, const double* xyz, size_t n,
+                                  S2CThreadPool* pool, int32_t* shape_ids, int32_t* edge_ids,
+                                  double* distances) {
+    if (!index || n > UINT32_MAX || (n > 0 && (!xyz || !shape_ids))) return false;
+    run_point_chunks(xyz, n, pool, nullptr, [&](const uint32_t* points, size_t count) {
+        S2ClosestEdgeQuery query(&index->index);
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t p = points[i];
+            S2ClosestEdgeQuery::PointTarget target(xyz_point(xyz, p));
+            S2ClosestEdgeQuery::Result result = query.FindClosestEdge(&target);
+            shape_ids[p] = result.shape_id();
+            if (edge_ids) edge_ids[p] = result.edge_id();
+            if (distances) distances[p] = result.is_empty() ? -1.0 : result.distance().ToAngle().radians();
+        }
+    });
+    return true;
+}
+
 // Memory management helpers
 void s2c_free_string(char* str) {
     free(str);
@@ -2448,18 +4557,13 @@ S2CCellId* s2c_cellunion_cell_id(const S2CCellUnion* cell_union, int i) {
     return cellid;
 }
 
-const uint64_t* s2c_cellunion_cell_ids(const S2CCellUnion* cell_union) {
+// S2CellId is a single uint64, so the union's storage is exposed directly
+static_assert(sizeof(S2CellId) == sizeof(uint64_t), "S2CellId must be a plain uint64");
+
+const uint64_t* s2c_cellunion_cell_ids(const S2CCellUnion* cell_union, int* num_cells) {
+    if (num_cells) *num_cells = cell_union ? cell_union->cell_union.num_cells() : 0;
     if (!cell_union) return nullptr;
-    
-    // We need to create a temporary array of uint64_t ids
-    // Note: This is not ideal as we're returning a pointer to temporary data
-    // A better approach would be to fill a provided buffer
-    static std::vector<uint64_t> ids;
-    ids.clear();
-    for (const auto& cellid : cell_union->cell_union.cell_ids()) {
-        ids.push_back(cellid.id());
-    }
-    return ids.data();
+    return reinterpret_cast<const uint64_t*>(cell_union->cell_union.cell_ids().data());
 }
 
 bool s2c_cellunion_empty(const S2CCellUnion* cell_union) {
@@ -2477,25 +4581,50 @@ void s2c_cellunion_normalize(S2CCellUnion* cell_union) {
     }
 }
 
-void s2c_cellunion_normalize_in_place(S2CCellId** cellids, int* num_cells) {
-    if (!cellids || !num_cells || *num_cells <= 0) return;
-    
-    std::vector<S2CellId> ids;
-    ids.reserve(*num_cells);
-    for (int i = 0; i < *num_cells; ++i) {
-        if (cellids[i]) {
-            ids.push_back(cellids[i]->cellid);
-            delete cellids[i];  // Clean up old cell ids
+// Same test as S2CellUnion's AreSiblings: a, b, c and d are the four children
+// of one parent, in any order
+static bool cell_ids_are_siblings(uint64_t a, uint64_t b, uint64_t c, uint64_t d) {
+    if ((a ^ b ^ c) != d) return false;
+    if (S2CellId(d).is_face()) return false;
+    uint64_t mask = S2CellId(d).lsb() << 1;
+    mask = ~(mask + (mask << 1));
+    uint64_t d_masked = d & mask;
+    return (a & mask) == d_masked && (b & mask) == d_masked && (c & mask) == d_masked;
+}
+
+int s2c_cellunion_normalize_in_place(uint64_t* cell_ids, int num_cells) {
+    if (!cell_ids || num_cells <= 0) return 0;
+
+    std::sort(cell_ids, cell_ids + num_cells);
+    int out = 0;
+    for (int i = 0; i < num_cells; ++i) {
+        S2CellId id(cell_ids[i]);
+        // Skip cells already covered by the previous output cell
+        if (out > 0 && S2CellId(cell_ids[out - 1]).contains(id)) continue;
+        // Discard previous output cells covered by this one
+        while (out > 0 && id.contains(S2CellId(cell_ids[out - 1]))) --out;
+        // Collapse four siblings into their parent
+        while (out >= 3 && cell_ids_are_siblings(cell_ids[out - 3], cell_ids[out - 2], cell_ids[out - 1], id.id())) {
+            id = id.parent();
+            out -= 3;
         }
+        cell_ids[out++] = id.id();
     }
-    
-    S2CellUnion::Normalize(&ids);
-    
-    *num_cells = ids.size();
-    for (size_t i = 0; i < ids.size(); ++i) {
-        cellids[i] = new S2CCellId;
-        cellids[i]->cellid = ids[i];
-    }
+    return out;
+}
+
+S2CCellUnion* s2c_cellunion_new_from_ids_take(uint64_t* cell_ids, int num_cells) {
+    if (!cell_ids) return nullptr;
+    // std::vector cannot adopt foreign memory, so the ids are normalized in
+    // the caller's buffer and copied into the union exactly once.
+    int count = s2c_cellunion_normalize_in_place(cell_ids, num_cells);
+    std::vector<S2CellId> ids(count);
+    if (count > 0) memcpy(ids.data(), cell_ids, sizeof(uint64_t) * count);
+    free(cell_ids);
+
+    auto* cell_union = new S2CCellUnion;
+    cell_union->cell_union = S2CellUnion::FromVerbatim(std::move(ids));
+    return cell_union;
 }
 
 void s2c_cellunion_denormalize(const S2CCellUnion* cell_union, int min_level, int level_mod, S2CCellId*** output, int* count) {
@@ -2553,6 +4682,136 @@ S2CCellUnion* s2c_cellunion_get_difference(const S2CCellUnion* a, const S2CCellU
     return result;
 }
 
+S2CCellUnion* s2c_cellunion_union(const S2CCellUnion* a, const S2CCellUnion* b) {
+    if (!a || !b) return nullptr;
+    auto* result = new S2CCellUnion;
+    result->cell_union = a->cell_union.Union(b->cell_union);
+    return result;
+}
+
+// The *_into variants reuse the storage of `out`, which may alias a or b
+void s2c_cellunion_union_into(const S2CCellUnion* a, const S2CCellUnion* b, S2CCellUnion* out) {
+    if (!a || !b || !out) return;
+    if (out == a || out == b) {
+        out->cell_union = a->cell_union.Union(b->cell_union);
+        return;
+    }
+    std::vector<S2CellId> ids = out->cell_union.Release();
+    ids.clear();
+    std::merge(a->cell_union.begin(), a->cell_union.end(),
+               b->cell_union.begin(), b->cell_union.end(), std::back_inserter(ids));
+    S2CellUnion::Normalize(&ids);
+    out->cell_union = S2CellUnion::FromVerbatim(std::move(ids));
+}
+
+void s2c_cellunion_intersection_into(const S2CCellUnion* a, const S2CCellUnion* b, S2CCellUnion* out) {
+    if (!a || !b || !out) return;
+    if (out == a || out == b) {
+        out->cell_union = a->cell_union.Intersection(b->cell_union);
+        return;
+    }
+    std::vector<S2CellId> ids = out->cell_union.Release();
+    ids.clear();
+    S2CellUnion::GetIntersection(a->cell_union.cell_ids(), b->cell_union.cell_ids(), &ids);
+    out->cell_union = S2CellUnion::FromVerbatim(std::move(ids));
+}
+
+// Appends the parts of cell not covered by y, as S2CellUnion::Difference does
+static void append_cell_difference(S2CellId cell, const S2CellUnion& y, std::vector<S2CellId>* ids) {
+    if (!y.Intersects(cell)) {
+        ids->push_back(cell);
+    } else if (!y.Contains(cell)) {
+        S2CellId child = cell.child_begin();
+        for (int i = 0; i < 4; ++i, child = child.next()) {
+            append_cell_difference(child, y, ids);
+        }
+    }
+}
+
+void s2c_cellunion_difference_into(const S2CCellUnion* a, const S2CCellUnion* b, S2CCellUnion* out) {
+    if (!a || !b || !out) return;
+    if (out == a || out == b) {
+        out->cell_union = a->cell_union.Difference(b->cell_union);
+        return;
+    }
+    std::vector<S2CellId> ids = out->cell_union.Release();
+    ids.clear();
+    for (S2CellId id : a->cell_union) append_cell_difference(id, b->cell_union, &ids);
+    // Normalized already: a is, and the pieces of each cell stay disjoint
+    out->cell_union = S2CellUnion::FromVerbatim(std::move(ids));
+}
+
+int s2c_cellunion_contains_ids(const S2CCellUnion* cell_union, const uint64_t* ids, int n, uint8_t* out) {
+    if (!cell_union || !ids || !out || n <= 0) return 0;
+
+    // A cell can only be contained by the union cell whose range includes its
+    // id, and union ranges are disjoint and sorted. Sorted ids therefore
+    // resolve in a single forward sweep; a decrease restarts with a binary
+    // search.
+    const std::vector<S2CellId>& cells = cell_union->cell_union.cell_ids();
+    size_t j = 0;
+    int count = 0;
+    for (int i = 0; i < n; ++i) {
+        S2CellId id(ids[i]);
+        if (i > 0 && ids[i] < ids[i - 1]) {
+            j = std::partition_point(cells.begin(), cells.end(),
+                                     [&](S2CellId c) { return c.range_max() < id; }) - cells.begin();
+        } else {
+            while (j < cells.size() && cells[j].range_max() < id) ++j;
+        }
+        out[i] = id.is_valid() && j < cells.size() && cells[j].contains(id);
+        count += out[i];
+    }
+    return count;
+}
+
+// Expansion and construction from leaf ranges
+void s2c_cellunion_expand_level(S2CCellUnion* cell_union, int level) {
+    if (cell_union && level >= 0 && level <= S2CellId::kMaxLevel) {
+        cell_union->cell_union.Expand(level);
+    }
+}
+
+void s2c_cellunion_expand_radius(S2CCellUnion* cell_union, double min_radius_radians, int max_level_diff) {
+    if (cell_union && min_radius_radians >= 0 && max_level_diff >= 0) {
+        cell_union->cell_union.Expand(S1Angle::Radians(min_radius_radians), max_level_diff);
+    }
+}
+
+static bool valid_leaf_range(S2CellId min_id, S2CellId max_id) {
+    return min_id.is_valid() && max_id.is_valid() && min_id.is_leaf() && max_id.is_leaf() && min_id <= max_id;
+}
+
+S2CCellUnion* s2c_cellunion_from_min_max(uint64_t min_id, uint64_t max_id) {
+    if (!valid_leaf_range(S2CellId(min_id), S2CellId(max_id))) return nullptr;
+    auto* result = new S2CCellUnion;
+    result->cell_union = S2CellUnion::FromMinMax(S2CellId(min_id), S2CellId(max_id));
+    return result;
+}
+
+S2CCellUnion* s2c_cellunion_from_begin_end(uint64_t begin, uint64_t end) {
+    if (begin > end || !S2CellId(begin).is_leaf() || !S2CellId(end).is_leaf()) return nullptr;
+    auto* result = new S2CCellUnion;
+    result->cell_union = S2CellUnion::FromBeginEnd(S2CellId(begin), S2CellId(end));
+    return result;
+}
+
+bool s2c_cellunion_init_from_min_max(S2CCellUnion* cell_union, uint64_t min_id, uint64_t max_id) {
+    if (!cell_union || !valid_leaf_range(S2CellId(min_id), S2CellId(max_id))) return false;
+    cell_union->cell_union.InitFromMinMax(S2CellId(min_id), S2CellId(max_id));
+    return true;
+}
+
+bool s2c_cellunion_init_from_begin_end(S2CCellUnion* cell_union, uint64_t begin, uint64_t end) {
+    if (!cell_union || begin > end || !S2CellId(begin).is_leaf() || !S2CellId(end).is_leaf()) return false;
+    cell_union->cell_union.InitFromBeginEnd(S2CellId(begin), S2CellId(end));
+    return true;
+}
+
+uint64_t s2c_cellunion_leaf_cells_covered(const S2CCellUnion* cell_union) {
+    return cell_union ? cell_union->cell_union.LeafCellsCovered() : 0;
+}
+
 // Other Operations
 bool s2c_cellunion_may_intersect_cell(const S2CCellUnion* cell_union, const S2CCell* cell) {
     return cell_union && cell ? cell_union->cell_union.MayIntersect(cell->cell) : false;
@@ -2799,47 +5058,121 @@ bool s2c_ordered_ccw(const S2CPoint* a, const S2CPoint* b, const S2CPoint* c, co
     return s2pred::OrderedCCW(a->point, b->point, c->point, o->point);
 }
 
-// Error handling functions
-S2CError* s2c_error_new(void) {
-    auto* error = new S2CError;
-    error->ok = true;
-    error->text = nullptr;
-    return error;
+// Error handling functions
+S2CError* s2c_error_new(void) {
+    auto* error = new S2CError;
+    error->ok = true;
+    error->text = nullptr;
+    error->code = S2C_ERROR_OK;
+    return error;
+}
+
+void s2c_error_destroy(S2CError* error) {
+    if (error) {
+        free(error->text);
+        delete error;
+    }
+}
+
+bool s2c_error_is_ok(const S2CError* error) {
+    return error ? error->ok : true;
+}
+
+int s2c_error_code(const S2CError* error) {
+    if (!error || error->ok) return S2C_ERROR_OK;
+    return error->code != S2C_ERROR_OK ? error->code : S2C_ERROR_UNKNOWN;
+}
+
+const char* s2c_error_message(const S2CError* error) {
+    return error ? error->text : nullptr;
+}
+
+void s2c_error_set(S2CError* error, int code, const char* message) {
+    if (error) {
+        error->ok = (code == 0);
+        error->code = code;
+        free(error->text);
+        error->text = message ? copy_string(message) : nullptr;
+    }
+}
+
+void s2c_error_clear(S2CError* error) {
+    if (error) {
+        error->ok = true;
+        error->code = S2C_ERROR_OK;
+        free(error->text);
+        error->text = nullptr;
+    }
+}
+
+// Cancellation token functions
+S2CCancelToken* s2c_cancel_token_new(void) {
+    return new S2CCancelToken;
+}
+
+void s2c_cancel_token_destroy(S2CCancelToken* token) {
+    delete token;
+}
+
+void s2c_cancel_token_cancel(S2CCancelToken* token) {
+    if (token) token->cancelled.store(true, std::memory_order_relaxed);
+}
+
+void s2c_cancel_token_set_deadline(S2CCancelToken* token, int64_t timeout_ms) {
+    if (!token) return;
+    int64_t deadline = timeout_ms < 0 ? INT64_MAX : steady_now_ns() + timeout_ms * 1000000;
+    token->deadline_ns.store(deadline, std::memory_order_relaxed);
+}
+
+bool s2c_cancel_token_is_cancelled(const S2CCancelToken* token) {
+    return cancel_token_expired(token);
+}
+
+void s2c_cancel_token_reset(S2CCancelToken* token) {
+    if (!token) return;
+    token->cancelled.store(false, std::memory_order_relaxed);
+    token->deadline_ns.store(INT64_MAX, std::memory_order_relaxed);
+}
+
+// Memory tracker functions
+S2CMemoryTracker* s2c_memory_tracker_new(int64_t limit_bytes) {
+    auto* tracker = new S2CMemoryTracker;
+    s2c_memory_tracker_set_limit(tracker, limit_bytes);
+    return tracker;
+}
+
+void s2c_memory_tracker_destroy(S2CMemoryTracker* tracker) {
+    delete tracker;
+}
+
+void s2c_memory_tracker_set_limit(S2CMemoryTracker* tracker, int64_t limit_bytes) {
+    if (tracker) tracker->limit.store(limit_bytes < 0 ? S2MemoryTracker::kNoLimit : limit_bytes);
 }
 
-void s2c_error_destroy(S2CError* error) {
-    if (error) {
-        free(error->text);
-        delete error;
-    }
+int64_t s2c_memory_tracker_limit(const S2CMemoryTracker* tracker) {
+    if (!tracker) return -1;
+    int64_t limit = tracker->limit.load();
+    return limit == S2MemoryTracker::kNoLimit ? -1 : limit;
 }
 
-bool s2c_error_is_ok(const S2CError* error) {
-    return error ? error->ok : true;
+int64_t s2c_memory_tracker_usage(const S2CMemoryTracker* tracker) {
+    return tracker ? tracker->usage.load() : 0;
 }
 
-int s2c_error_code(const S2CError* error) {
-    return error && !error->ok ? 1 : 0;
+int64_t s2c_memory_tracker_peak_usage(const S2CMemoryTracker* tracker) {
+    return tracker ? tracker->peak.load() : 0;
 }
 
-const char* s2c_error_message(const S2CError* error) {
-    return error ? error->text : nullptr;
+void s2c_memory_tracker_reset_peak_usage(S2CMemoryTracker* tracker) {
+    if (tracker) tracker->peak.store(tracker->usage.load());
 }
 
-void s2c_error_set(S2CError* error, int code, const char* message) {
-    if (error) {
-        error->ok = (code == 0);
-        free(error->text);
-        error->text = message ? copy_string(message) : nullptr;
-    }
+int s2c_last_error_code(void) {
+    return last_error().code;
 }
 
-void s2c_error_clear(S2CError* error) {
-    if (error) {
-        error->ok = true;
-        free(error->text);
-        error->text = nullptr;
-    }
+const char* s2c_last_error_message(void) {
+    return last_error().message.c_str();
 }
 
 void s2c_free_cellid_array(S2CCellId** array, int count) {
@@ -2860,6 +5193,19 @@ void s2c_free_polyline_array(S2CPolyline** array, int count) {
     }
 }
 
+void s2c_free_loop_array(S2CLoop** array, int count) {
+    if (array) {
+        for (int i = 0; i < count; ++i) {
+            delete array[i];
+        }
+        free(array);
+    }
+}
+
+void s2c_free_buffer(void* buffer) {
+    free(buffer);
+}
+
 // S2LatLngRect implementation
 S2CLatLngRect* s2c_latlngrect_new(void) {
     return new S2CLatLngRect{S2LatLngRect::Empty()};
@@ -3226,6 +5572,180 @@ void s2c_regioncoverer_get_covering_polygon(S2CRegionCoverer* coverer, const S2C
     }
 }
 
+// S2RegionCoverer batch covering functions
+static const S2Region* region_ref_region(const S2CRegionRef& ref) {
+    if (!ref.region) return nullptr;
+    switch (ref.type) {
+        case S2C_REGION_CAP: return &static_cast<const S2CCap*>(ref.region)->cap;
+        case S2C_REGION_RECT: return &static_cast<const S2CLatLngRect*>(ref.region)->rect;
+        case S2C_REGION_CELL: return &static_cast<const S2CCell*>(ref.region)->cell;
+        case S2C_REGION_POLYGON: return static_cast<const S2CPolygon*>(ref.region)->polygon.get();
+    }
+    return nullptr;
+}
+
+// Returns -1, leaving the outputs NULL, if cancelled is set before every
+// region has been covered.
+static int64_t coverings_batch(const S2RegionCoverer::Options& options, const S2CRegionRef* regions,
+                               int num_regions, bool interior, S2CThreadPool* pool, int num_threads,
+                               const std::atomic<bool>* cancelled, uint64_t** out_ids, int64_t** out_offsets) {
+    // Regions are covered in fixed-size chunks; each chunk owns its output so
+    // workers never share a vector, and each worker owns its S2RegionCoverer.
+    const int kChunkSize = 64;
+    int num_chunks = (num_regions + kChunkSize - 1) / kChunkSize;
+    std::vector<std::vector<uint64_t>> chunk_ids(num_chunks);
+    std::vector<int64_t> counts(num_regions, 0);
+
+    run_parallel(pool, num_threads, num_chunks, [&](int chunk) {
+        if (is_cancelled(cancelled)) return;
+        std::vector<S2CellId> cells;
+        S2RegionCoverer local_coverer(options);
+        int end = std::min(num_regions, (chunk + 1) * kChunkSize);
+        for (int i = chunk * kChunkSize; i < end; ++i) {
+            const S2Region* region = region_ref_region(regions[i]);
+            if (!region) continue;
+            if (interior) {
+                local_coverer.GetInteriorCovering(*region, &cells);
+            } else {
+                local_coverer.GetCovering(*region, &cells);
+            }
+            counts[i] = cells.size();
+            for (const S2CellId& id : cells) {
+                chunk_ids[chunk].push_back(id.id());
+            }
+        }
+    });
+    if (is_cancelled(cancelled)) return -1;
+
+    *out_offsets = (int64_t*)malloc(sizeof(int64_t) * (num_regions + 1));
+    (*out_offsets)[0] = 0;
+    for (int i = 0; i < num_regions; ++i) {
+        (*out_offsets)[i + 1] = (*out_offsets)[i] + counts[i];
+    }
+    int64_t total = (*out_offsets)[num_regions];
+    *out_ids = (uint64_t*)malloc(sizeof(uint64_t) * std::max<int64_t>(total, 1));
+    uint64_t* dst = *out_ids;
+    for (const auto& ids : chunk_ids) {
+        if (!ids.empty()) memcpy(dst, ids.data(), sizeof(uint64_t) * ids.size());
+        dst += ids.size();
+    }
+    return total;
+}
+
+int64_t s2c_regioncoverer_get_coverings_batch(const S2CRegionCoverer* coverer, const S2CRegionRef* regions,
+                                              int num_regions, bool interior, int num_threads,
+                                              uint64_t** out_ids, int64_t** out_offsets) {
+    if (out_ids) *out_ids = nullptr;
+    if (out_offsets) *out_offsets = nullptr;
+    if (!coverer || !regions || !out_ids || !out_offsets || num_regions < 0) return 0;
+    return coverings_batch(coverer->coverer.options(), regions, num_regions, interior, nullptr, num_threads,
+                           nullptr, out_ids, out_offsets);
+}
+
+S2CTask* s2c_regioncoverer_get_coverings_batch_async(const S2CRegionCoverer* coverer, const S2CRegionRef* regions,
+                                                     int num_regions, bool interior, S2CThreadPool* pool,
+                                                     uint64_t** out_ids, int64_t** out_offsets,
+                                                     S2CTaskCallback callback, void* user_data) {
+    if (out_ids) *out_ids = nullptr;
+    if (out_offsets) *out_offsets = nullptr;
+    if (!coverer || !regions || !out_ids || !out_offsets || num_regions < 0) return nullptr;
+    // Options are copied now so the coverer may change while the task runs
+    S2RegionCoverer::Options options = coverer->coverer.options();
+    return submit_task(pool, callback, user_data,
+                       [=](const std::atomic<bool>* cancelled, int64_t* result) {
+                           *result = coverings_batch(options, regions, num_regions, interior, pool, 0,
+                                                     cancelled, out_ids, out_offsets);
+                           return *result >= 0;
+                       });
+}
+
+// S2RegionCoverer fixed-level covering functions
+// Appends the level-`level` descendants of id that may intersect region, in
+// S2CellId order. Blocks fully contained in the region are enumerated
+// directly without further intersection tests.
+static void append_fixed_level_cells(const S2Region& region, S2CellId id, int level, std::vector<uint64_t>* out) {
+    S2Cell cell(id);
+    if (!region.MayIntersect(cell)) return;
+    if (id.level() == level) {
+        out->push_back(id.id());
+        return;
+    }
+    if (region.Contains(cell)) {
+        for (S2CellId c = id.child_begin(level), end = id.child_end(level); c != end; c = c.next()) {
+            out->push_back(c.id());
+        }
+        return;
+    }
+    for (S2CellId c = id.child_begin(), end = id.child_end(); c != end; c = c.next()) {
+        append_fixed_level_cells(region, c, level, out);
+    }
+}
+
+static int64_t fixed_level_covering(const S2Region& region, int level, uint64_t** out_ids) {
+    std::vector<S2CellId> starts;
+    region.GetCellUnionBound(&starts);
+    for (S2CellId& id : starts) {
+        if (id.level() > level) id = id.parent(level);
+    }
+    S2CellUnion::Normalize(&starts);
+
+    std::vector<uint64_t> ids;
+    for (S2CellId id : starts) {
+        append_fixed_level_cells(region, id, level, &ids);
+    }
+    *out_ids = (uint64_t*)malloc(sizeof(uint64_t) * std::max<size_t>(ids.size(), 1));
+    if (!ids.empty()) memcpy(*out_ids, ids.data(), sizeof(uint64_t) * ids.size());
+    return ids.size();
+}
+
+int64_t s2c_regioncoverer_fixed_level_covering_cap(const S2CCap* cap, int level, uint64_t** out_ids) {
+    if (out_ids) *out_ids = nullptr;
+    if (!cap || !out_ids || level < 0 || level > S2CellId::kMaxLevel) return 0;
+    return fixed_level_covering(cap->cap, level, out_ids);
+}
+
+int64_t s2c_regioncoverer_fixed_level_covering_rect(const S2CLatLngRect* rect, int level, uint64_t** out_ids) {
+    if (out_ids) *out_ids = nullptr;
+    if (!rect || !out_ids || level < 0 || level > S2CellId::kMaxLevel) return 0;
+    return fixed_level_covering(rect->rect, level, out_ids);
+}
+
+// S2RegionCoverer shape index covering functions
+static int64_t copy_cell_ids(const std::vector<S2CellId>& cells, uint64_t** out_ids) {
+    *out_ids = (uint64_t*)malloc(sizeof(uint64_t) * std::max<size_t>(cells.size(), 1));
+    for (size_t i = 0; i < cells.size(); ++i) {
+        (*out_ids)[i] = cells[i].id();
+    }
+    return cells.size();
+}
+
+int64_t s2c_regioncoverer_get_covering_shape_index(S2CRegionCoverer* coverer, const S2CMutableShapeIndex* index,
+                                                   bool interior, uint64_t** out_ids) {
+    if (out_ids) *out_ids = nullptr;
+    if (!coverer || !index || !out_ids) return 0;
+
+    auto region = MakeS2ShapeIndexRegion(&index->index);
+    std::vector<S2CellId> cells;
+    if (interior) {
+        coverer->coverer.GetInteriorCovering(region, &cells);
+    } else {
+        coverer->coverer.GetCovering(region, &cells);
+    }
+    return copy_cell_ids(cells, out_ids);
+}
+
+int64_t s2c_regioncoverer_get_covering_buffered_shape_index(S2CRegionCoverer* coverer,
+                                                            const S2CMutableShapeIndex* index,
+                                                            double radius_radians, uint64_t** out_ids) {
+    if (out_ids) *out_ids = nullptr;
+    if (!coverer || !index || !out_ids || radius_radians < 0) return 0;
+
+    S2ShapeIndexBufferedRegion region(&index->index, S1ChordAngle(S1Angle::Radians(radius_radians)));
+    std::vector<S2CellId> cells;
+    coverer->coverer.GetCovering(region, &cells);
+    return copy_cell_ids(cells, out_ids);
+}
+
 // S2RegionCoverer interior covering functions
 void s2c_regioncoverer_get_interior_covering_cap(S2CRegionCoverer* coverer, const S2CCap* cap, S2CCellId*** interior, int* count) {
     if (!coverer || !cap || !interior || !count) {
@@ -3305,4 +5825,735 @@ void s2c_regioncoverer_get_interior_covering_polygon(S2CRegionCoverer* coverer,
     } else {
         *interior = nullptr;
     }
-}
\ No newline at end of file
+}
+
+// S2CoveringCache functions
+// The cache key is the region type, the coverer options and the encoded
+// region. Keeping the full bytes in the key avoids false hits on hash
+// collisions.
+static bool covering_cache_key(const S2RegionCoverer::Options& options, const S2CRegionRef& ref,
+                               bool interior, std::string* key) {
+    if (!ref.region) return false;
+    int header[6] = {ref.type, interior, options.max_cells(), options.min_level(),
+                     options.max_level(), options.level_mod()};
+    key->assign(reinterpret_cast<const char*>(header), sizeof(header));
+
+    Encoder encoder;
+    switch (ref.type) {
+        case S2C_REGION_CAP:
+            static_cast<const S2CCap*>(ref.region)->cap.Encode(&encoder);
+            break;
+        case S2C_REGION_RECT:
+            static_cast<const S2CLatLngRect*>(ref.region)->rect.Encode(&encoder);
+            break;
+        case S2C_REGION_CELL: {
+            uint64_t id = static_cast<const S2CCell*>(ref.region)->cell.id().id();
+            key->append(reinterpret_cast<const char*>(&id), sizeof(id));
+            return true;
+        }
+        case S2C_REGION_POLYGON:
+            static_cast<const S2CPolygon*>(ref.region)->polygon->Encode(&encoder);
+            break;
+        default:
+            return false;
+    }
+    key->append(encoder.base(), encoder.length());
+    return true;
+}
+
+S2CCoveringCache* s2c_covering_cache_new(size_t max_entries) {
+    auto* cache = new S2CCoveringCache;
+    cache->max_entries = std::max<size_t>(max_entries, 1);
+    return cache;
+}
+
+void s2c_covering_cache_destroy(S2CCoveringCache* cache) {
+    delete cache;
+}
+
+S2CCovering* s2c_covering_cache_get(S2CCoveringCache* cache, const S2CRegionCoverer* coverer,
+                                    const S2CRegionRef* region, bool interior) {
+    if (!cache || !coverer || !region) return nullptr;
+    const S2Region* s2_region = region_ref_region(*region);
+    std::string key;
+    if (!s2_region || !covering_cache_key(coverer->coverer.options(), *region, interior, &key)) {
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        auto it = cache->entries.find(key);
+        if (it != cache->entries.end()) {
+            ++cache->hits;
+            cache->lru.splice(cache->lru.begin(), cache->lru, it->second);
+            return new S2CCovering{it->second->second};
+        }
+        ++cache->misses;
+    }
+
+    // Cover outside the lock so that misses on different regions run concurrently
+    S2RegionCoverer local_coverer(coverer->coverer.options());
+    std::vector<S2CellId> cells;
+    if (interior) {
+        local_coverer.GetInteriorCovering(*s2_region, &cells);
+    } else {
+        local_coverer.GetCovering(*s2_region, &cells);
+    }
+    auto ids = std::make_shared<std::vector<uint64_t>>(cells.size());
+    for (size_t i = 0; i < cells.size(); ++i) {
+        (*ids)[i] = cells[i].id();
+    }
+
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    auto it = cache->entries.find(key);
+    if (it != cache->entries.end()) {
+        // Another thread inserted the same covering first
+        cache->lru.splice(cache->lru.begin(), cache->lru, it->second);
+        return new S2CCovering{it->second->second};
+    }
+    cache->lru.emplace_front(key, ids);
+    cache->entries.emplace(std::move(key), cache->lru.begin());
+    while (cache->entries.size() > cache->max_entries) {
+        cache->entries.erase(cache->lru.back().first);
+        cache->lru.pop_back();
+    }
+    return new S2CCovering{cache->lru.front().second};
+}
+
+void s2c_covering_cache_clear(S2CCoveringCache* cache) {
+    if (!cache) return;
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    cache->entries.clear();
+    cache->lru.clear();
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+size_t s2c_covering_cache_size(S2CCoveringCache* cache) {
+    if (!cache) return 0;
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    return cache->entries.size();
+}
+
+uint64_t s2c_covering_cache_hits(S2CCoveringCache* cache) {
+    if (!cache) return 0;
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    return cache->hits;
+}
+
+uint64_t s2c_covering_cache_misses(S2CCoveringCache* cache) {
+    if (!cache) return 0;
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    return cache->misses;
+}
+
+const uint64_t* s2c_covering_ids(const S2CCovering* covering) {
+    if (!covering) return nullptr;
+    return covering->ids->data();
+}
+
+int64_t s2c_covering_size(const S2CCovering* covering) {
+    if (!covering) return 0;
+    return covering->ids->size();
+}
+
+void s2c_covering_destroy(S2CCovering* covering) {
+    delete covering;
+}
+
+// Synthetic workload generator functions
+
+// SplitMix64: tiny state and fully specified, so streams are cheap to fork per
+// item and identical on every platform (unlike the std distributions)
+struct GeneratorRng {
+    uint64_t state;
+
+    explicit GeneratorRng(uint64_t seed) : state(seed) {}
+
+    uint64_t Next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+    // Uniform in [0, 1)
+    double Uniform() { return (Next() >> 11) * 0x1.0p-53; }
+    // Standard normal (Box-Muller)
+    double Normal() {
+        double u = 1.0 - Uniform();
+        return std::sqrt(-2.0 * std::log(u)) * std::cos(2 * M_PI * Uniform());
+    }
+};
+
+static uint64_t mix_seed(uint64_t seed, uint64_t stream) {
+    return GeneratorRng(seed ^ (stream * 0xd1b54a32d192ed03ULL)).Next();
+}
+
+static constexpr uint64_t kClusterStream = ~uint64_t{0};
+static constexpr int kPointsPerChunk = 4096;
+static constexpr int kPlacementAttempts = 16;
+
+static void tangent_frame(const S2Point& p, S2Point* east, S2Point* north) {
+    S2Point e = S2Point(0, 0, 1).CrossProd(p);
+    if (e.Norm2() < 1e-24) e = S2::Ortho(p);  // At the poles
+    *east = e.Normalize();
+    *north = p.CrossProd(*east);
+}
+
+// Moves dx radians east and dy radians north of p along a great circle
+static S2Point offset_point(const S2Point& p, double dx, double dy) {
+    double dist = std::hypot(dx, dy);
+    if (dist == 0) return p;
+    S2Point east, north;
+    tangent_frame(p, &east, &north);
+    S2Point dir = (dx / dist) * east + (dy / dist) * north;
+    return (std::cos(dist) * p + std::sin(dist) * dir).Normalize();
+}
+
+static S2Point generator_sample(const S2CGenerator* generator, GeneratorRng* rng) {
+    if (!generator->clusters.empty()) {
+        const S2Point& center = generator->clusters[rng->Next() % generator->clusters.size()];
+        return offset_point(center, rng->Normal() * generator->spread_radians,
+                            rng->Normal() * generator->spread_radians);
+    }
+    // Uniform in area: cap height is linear in area
+    double height = rng->Uniform() * generator->region_height;
+    double dist = std::acos(std::max(-1.0, 1.0 - height));
+    double azimuth = 2 * M_PI * rng->Uniform();
+    return offset_point(generator->region_center, dist * std::cos(azimuth), dist * std::sin(azimuth));
+}
+
+static void generator_update_clusters(S2CGenerator* generator) {
+    // Centers are drawn from the region itself, so clear the old ones first
+    generator->clusters.clear();
+    GeneratorRng rng(mix_seed(generator->seed, kClusterStream));
+    std::vector<S2Point> clusters;
+    for (int i = 0; i < generator->num_clusters; ++i) clusters.push_back(generator_sample(generator, &rng));
+    generator->clusters = std::move(clusters);
+}
+
+static inline void store_xyz(const S2Point& p, double* out) {
+    out[0] = p.x();
+    out[1] = p.y();
+    out[2] = p.z();
+}
+
+// Fraction of a ring's band left clear on each side of its vertices
+static const double kRingMargin = 0.05;
+
+// Writes a star-shaped loop of n vertices around center into out. Vertex
+// distances stay within the band (inner, outer) less kRingMargin on each
+// side; ring_bands keeps nested rings apart. Detail comes from octaves of
+// sines at integer frequencies, which keeps the outline closed.
+static void write_ring(const S2Point& center, int n, double inner, double outer, double roughness,
+                       bool clockwise, GeneratorRng* rng, double* out) {
+    constexpr double kPersistence = 0.6;
+    int num_octaves = 1;
+    while ((4 << num_octaves) <= n && num_octaves < 16) ++num_octaves;
+    double phases[16];
+    double total_weight = 0.0;
+    for (int o = 0; o < num_octaves; ++o) phases[o] = 2 * M_PI * rng->Uniform();
+    for (int o = 0; o < num_octaves; ++o) total_weight += std::pow(kPersistence, o);
+    double rotation = 2 * M_PI * rng->Uniform() / n;
+
+    S2Point east, north;
+    tangent_frame(center, &east, &north);
+    for (int j = 0; j < n; ++j) {
+        double theta = rotation + 2 * M_PI * j / n;
+        double detail = 0.0;
+        double weight = 1.0;
+        for (int o = 0; o < num_octaves; ++o) {
+            detail += weight * std::sin((2 << o) * theta + phases[o]);
+            weight *= kPersistence;
+        }
+        double t = 0.5 * (1.0 + detail / total_weight) * roughness;
+        double rho = outer - (outer - inner) * (kRingMargin + (1 - 2 * kRingMargin) * t);
+        S2Point dir = std::cos(theta) * east + std::sin(theta) * north;
+        S2Point vertex = (std::cos(rho) * center + std::sin(rho) * dir).Normalize();
+        store_xyz(vertex, out + 3 * (clockwise ? n - 1 - j : j));
+    }
+}
+
+// One center per item. With probability overlap an item lands within a
+// radius or so of an earlier center; otherwise up to kPlacementAttempts draws
+// look for a spot at least two radii from every earlier center.
+static std::vector<S2Point> place_centers(const S2CGenerator* generator, GeneratorRng* rng, int n,
+                                          double radius) {
+    std::vector<S2Point> centers;
+    centers.reserve(n);
+    int level = S2::kMinWidth.GetLevelForMinValue(2 * radius);
+    std::unordered_multimap<uint64_t, int> grid;
+    std::vector<S2CellId> nearby;
+    auto is_clear = [&](const S2Point& p) {
+        S2CellId cell = S2CellId(p).parent(level);
+        nearby.clear();
+        cell.AppendAllNeighbors(level, &nearby);
+        nearby.push_back(cell);
+        for (S2CellId id : nearby) {
+            auto range = grid.equal_range(id.id());
+            for (auto it = range.first; it != range.second; ++it) {
+                if (centers[it->second].Angle(p) < 2 * radius) return false;
+            }
+        }
+        return true;
+    };
+
+    for (int i = 0; i < n; ++i) {
+        S2Point center;
+        if (i > 0 && rng->Uniform() < generator->overlap) {
+            const S2Point& other = centers[rng->Next() % i];
+            double dist = radius * (0.25 + rng->Uniform());
+            double azimuth = 2 * M_PI * rng->Uniform();
+            center = offset_point(other, dist * std::cos(azimuth), dist * std::sin(azimuth));
+        } else {
+            center = generator_sample(generator, rng);
+            for (int attempt = 1; attempt < kPlacementAttempts && !is_clear(center); ++attempt) {
+                center = generator_sample(generator, rng);
+            }
+        }
+        grid.emplace(S2CellId(center).parent(level).id(), i);
+        centers.push_back(center);
+    }
+    return centers;
+}
+
+// Bands (inner, outer) of the nested rings of one item, outermost first.
+// Edges bulge inward: two vertices at distance lo from the center and 2π/n
+// apart are joined by an edge that comes within atan(tan(lo) cos(π/n)) of
+// it. So ring k + 1 must end inside that, not at ring k's inner radius; what
+// is left is shared equally by the remaining rings, and the innermost ring
+// reaches the center.
+static std::vector<R1Interval> ring_bands(int num_vertices, int nesting_depth, double radius) {
+    constexpr double kRingGap = 0.99;  // Slack below the closest edge of the ring outside
+    double bulge = std::cos(M_PI / num_vertices);
+    std::vector<R1Interval> bands;
+    bands.reserve(nesting_depth);
+    double outer = radius;
+    for (int k = 0; k < nesting_depth; ++k) {
+        int remaining = nesting_depth - k;
+        double inner = outer * (remaining - 1) / remaining;
+        bands.push_back(R1Interval(inner, outer));
+        double closest_vertex = inner + kRingMargin * (outer - inner);
+        outer = std::atan(kRingGap * bulge * std::tan(closest_vertex));
+    }
+    return bands;
+}
+
+static bool valid_ring_args(int num_items, int num_vertices, int nesting_depth, double radius_degrees,
+                            double roughness) {
+    // Below this spacing neighbouring vertices of the innermost ring may coincide
+    constexpr double kMinVertexSpacing = 1e-13;
+    if (!(num_items > 0 && num_vertices >= 3 && nesting_depth >= 1 && radius_degrees > 0 &&
+          radius_degrees < 90 && roughness >= 0 && roughness <= 1 &&
+          static_cast<int64_t>(num_items) * num_vertices * nesting_depth <= std::numeric_limits<int>::max())) {
+        return false;
+    }
+    // Bands shrink geometrically with depth, faster at low vertex counts
+    R1Interval innermost =
+        ring_bands(num_vertices, nesting_depth, S1Angle::Degrees(radius_degrees).radians()).back();
+    double closest_vertex = innermost.lo() + kRingMargin * innermost.GetLength();
+    return 2 * M_PI * closest_vertex / num_vertices >= kMinVertexSpacing;
+}
+
+// Writes num_items groups of nesting_depth concentric rings into xyz (already
+// sized); ring k of an item is a hole when k is odd
+static void generate_rings(S2CGenerator* generator, int num_items, int num_vertices, int nesting_depth,
+                           double radius_degrees, double roughness, double* xyz) {
+    uint64_t call_seed = mix_seed(generator->seed, ++generator->calls);
+    GeneratorRng rng(call_seed);
+    double radius = S1Angle::Degrees(radius_degrees).radians();
+    std::vector<S2Point> centers = place_centers(generator, &rng, num_items, radius);
+
+    std::vector<R1Interval> bands = ring_bands(num_vertices, nesting_depth, radius);
+    int64_t item_size = static_cast<int64_t>(num_vertices) * nesting_depth;
+    run_parallel(0, num_items, [&](int i) {
+        GeneratorRng item_rng(mix_seed(call_seed, i + 1));
+        for (int k = 0; k < nesting_depth; ++k) {
+            write_ring(centers[i], num_vertices, bands[k].lo(), bands[k].hi(), roughness, k % 2 == 1,
+                       &item_rng, xyz + 3 * (i * item_size + static_cast<int64_t>(k) * num_vertices));
+        }
+    });
+}
+
+static void generate_walks(S2CGenerator* generator, int num_polylines, int num_vertices, double step_degrees,
+                           double noise_degrees, double* xyz) {
+    constexpr double kTurnStdDev = 0.3;  // Radians of heading change per step
+    uint64_t call_seed = mix_seed(generator->seed, ++generator->calls);
+    double step = S1Angle::Degrees(step_degrees).radians();
+    double noise = S1Angle::Degrees(noise_degrees).radians();
+    run_parallel(0, num_polylines, [&](int i) {
+        GeneratorRng rng(mix_seed(call_seed, i + 1));
+        S2Point position = generator_sample(generator, &rng);
+        double heading = 2 * M_PI * rng.Uniform();
+        double* out = xyz + 3 * static_cast<int64_t>(i) * num_vertices;
+        for (int j = 0; j < num_vertices; ++j) {
+            if (j > 0) {
+                heading += kTurnStdDev * rng.Normal();
+                double dist = step * (0.5 + rng.Uniform());
+                position = offset_point(position, dist * std::sin(heading), dist * std::cos(heading));
+            }
+            S2Point observed = noise > 0 ?
+                offset_point(position, noise * rng.Normal(), noise * rng.Normal()) : position;
+            store_xyz(observed, out + 3 * j);
+        }
+    });
+}
+
+static bool valid_walk_args(int num_polylines, int num_vertices, double step_degrees, double noise_degrees) {
+    return num_polylines > 0 && num_vertices >= 2 && step_degrees > 0 && noise_degrees >= 0 &&
+           static_cast<int64_t>(num_polylines) * num_vertices <= std::numeric_limits<int>::max();
+}
+
+static int* uniform_offsets(int num_items, int item_size) {
+    int* offsets = (int*)malloc(sizeof(int) * (num_items + 1));
+    for (int i = 0; i <= num_items; ++i) offsets[i] = i * item_size;
+    return offsets;
+}
+
+// Encodes item i with encode(i, &encoder) in parallel and packs the results
+static int pack_encodings(int num_items, const std::function<void(int, Encoder*)>& encode, char** out_bytes,
+                          int64_t** out_offsets) {
+    std::vector<std::string> encodings(num_items);
+    run_parallel(0, num_items, [&](int i) {
+        Encoder encoder;
+        encode(i, &encoder);
+        encodings[i].assign(encoder.base(), encoder.length());
+    });
+    *out_offsets = (int64_t*)malloc(sizeof(int64_t) * (num_items + 1));
+    (*out_offsets)[0] = 0;
+    for (int i = 0; i < num_items; ++i) (*out_offsets)[i + 1] = (*out_offsets)[i] + encodings[i].size();
+    *out_bytes = (char*)malloc(std::max<int64_t>((*out_offsets)[num_items], 1));
+    for (int i = 0; i < num_items; ++i) {
+        memcpy(*out_bytes + (*out_offsets)[i], encodings[i].data(), encodings[i].size());
+    }
+    return num_items;
+}
+
+S2CGenerator* s2c_generator_new(uint64_t seed) {
+    auto* generator = new S2CGenerator;
+    generator->seed = seed;
+    return generator;
+}
+
+void s2c_generator_destroy(S2CGenerator* generator) {
+    delete generator;
+}
+
+void s2c_generator_reseed(S2CGenerator* generator, uint64_t seed) {
+    if (!generator) return;
+    generator->seed = seed;
+    generator->calls = 0;
+    generator_update_clusters(generator);
+}
+
+void s2c_generator_set_region(S2CGenerator* generator, double lat_degrees, double lng_degrees,
+                              double radius_degrees) {
+    if (!generator || !(radius_degrees >= 0)) return;
+    generator->region_center = S2LatLng::FromDegrees(lat_degrees, lng_degrees).Normalized().ToPoint();
+    generator->region_height = radius_degrees >= 180 ? 2.0 :
+        S2Cap(generator->region_center, S1Angle::Degrees(radius_degrees)).height();
+    generator_update_clusters(generator);
+}
+
+void s2c_generator_set_clustering(S2CGenerator* generator, int num_clusters, double spread_degrees) {
+    if (!generator || !(spread_degrees >= 0)) return;
+    generator->num_clusters = std::max(num_clusters, 0);
+    generator->spread_radians = S1Angle::Degrees(spread_degrees).radians();
+    generator_update_clusters(generator);
+}
+
+void s2c_generator_set_overlap(S2CGenerator* generator, double overlap) {
+    if (!generator || !(overlap >= 0 && overlap <= 1)) return;
+    generator->overlap = overlap;
+}
+
+int64_t s2c_generate_points(S2CGenerator* generator, int64_t num_points, double** out_xyz) {
+    if (out_xyz) *out_xyz = nullptr;
+    if (!generator || !out_xyz || num_points <= 0) return 0;
+    int64_t num_chunks = (num_points + kPointsPerChunk - 1) / kPointsPerChunk;
+    if (num_chunks > std::numeric_limits<int>::max()) return 0;
+
+    *out_xyz = (double*)malloc(sizeof(double) * 3 * num_points);
+    if (!*out_xyz) return 0;
+    uint64_t call_seed = mix_seed(generator->seed, ++generator->calls);
+    run_parallel(0, static_cast<int>(num_chunks), [&](int chunk) {
+        GeneratorRng rng(mix_seed(call_seed, chunk + 1));
+        int64_t end = std::min<int64_t>(num_points, (chunk + 1) * static_cast<int64_t>(kPointsPerChunk));
+        for (int64_t i = chunk * static_cast<int64_t>(kPointsPerChunk); i < end; ++i) {
+            store_xyz(generator_sample(generator, &rng), *out_xyz + 3 * i);
+        }
+    });
+    return num_points;
+}
+
+int s2c_generate_polylines(S2CGenerator* generator, int num_polylines, int num_vertices,
+                           double step_degrees, double noise_degrees, double** out_xyz, int** out_offsets) {
+    if (out_xyz) *out_xyz = nullptr;
+    if (out_offsets) *out_offsets = nullptr;
+    if (!generator || !out_xyz || !out_offsets ||
+        !valid_walk_args(num_polylines, num_vertices, step_degrees, noise_degrees)) {
+        return 0;
+    }
+
+    *out_xyz = (double*)malloc(sizeof(double) * 3 * num_polylines * static_cast<int64_t>(num_vertices));
+    generate_walks(generator, num_polylines, num_vertices, step_degrees, noise_degrees, *out_xyz);
+    *out_offsets = uniform_offsets(num_polylines, num_vertices);
+    return num_polylines;
+}
+
+int s2c_generate_loops(S2CGenerator* generator, int num_loops, int num_vertices, double radius_degrees,
+                       double roughness, double** out_xyz, int** out_offsets) {
+    if (out_xyz) *out_xyz = nullptr;
+    if (out_offsets) *out_offsets = nullptr;
+    if (!generator || !out_xyz || !out_offsets ||
+        !valid_ring_args(num_loops, num_vertices, 1, radius_degrees, roughness)) {
+        return 0;
+    }
+
+    *out_xyz = (double*)malloc(sizeof(double) * 3 * num_loops * static_cast<int64_t>(num_vertices));
+    generate_rings(generator, num_loops, num_vertices, 1, radius_degrees, roughness, *out_xyz);
+    *out_offsets = uniform_offsets(num_loops, num_vertices);
+    return num_loops;
+}
+
+int s2c_generate_polygons(S2CGenerator* generator, int num_polygons, int num_vertices, int nesting_depth,
+                          double radius_degrees, double roughness, double** out_xyz,
+                          int** out_loop_offsets, int** out_polygon_offsets) {
+    if (out_xyz) *out_xyz = nullptr;
+    if (out_loop_offsets) *out_loop_offsets = nullptr;
+    if (out_polygon_offsets) *out_polygon_offsets = nullptr;
+    if (!generator || !out_xyz || !out_loop_offsets || !out_polygon_offsets ||
+        !valid_ring_args(num_polygons, num_vertices, nesting_depth, radius_degrees, roughness)) {
+        return 0;
+    }
+
+    int num_loops = num_polygons * nesting_depth;
+    *out_xyz = (double*)malloc(sizeof(double) * 3 * num_loops * static_cast<int64_t>(num_vertices));
+    generate_rings(generator, num_polygons, num_vertices, nesting_depth, radius_degrees, roughness, *out_xyz);
+    *out_loop_offsets = uniform_offsets(num_loops, num_vertices);
+    *out_polygon_offsets = uniform_offsets(num_polygons, nesting_depth);
+    return num_polygons;
+}
+
+int s2c_generate_polylines_encoded(S2CGenerator* generator, int num_polylines, int num_vertices,
+                                   double step_degrees, double noise_degrees, char** out_bytes,
+                                   int64_t** out_offsets) {
+    if (out_bytes) *out_bytes = nullptr;
+    if (out_offsets) *out_offsets = nullptr;
+    if (!generator || !out_bytes || !out_offsets ||
+        !valid_walk_args(num_polylines, num_vertices, step_degrees, noise_degrees)) {
+        return 0;
+    }
+
+    std::vector<double> xyz(3 * num_polylines * static_cast<size_t>(num_vertices));
+    generate_walks(generator, num_polylines, num_vertices, step_degrees, noise_degrees, xyz.data());
+    return pack_encodings(num_polylines, [&](int i, Encoder* encoder) {
+        int begin = i * num_vertices;
+        S2Polyline(xyz_points(xyz.data(), begin, begin + num_vertices), S2Debug::DISABLE).Encode(encoder);
+    }, out_bytes, out_offsets);
+}
+
+int s2c_generate_loops_encoded(S2CGenerator* generator, int num_loops, int num_vertices, double radius_degrees,
+                               double roughness, char** out_bytes, int64_t** out_offsets) {
+    if (out_bytes) *out_bytes = nullptr;
+    if (out_offsets) *out_offsets = nullptr;
+    if (!generator || !out_bytes || !out_offsets ||
+        !valid_ring_args(num_loops, num_vertices, 1, radius_degrees, roughness)) {
+        return 0;
+    }
+
+    std::vector<double> xyz(3 * num_loops * static_cast<size_t>(num_vertices));
+    generate_rings(generator, num_loops, num_vertices, 1, radius_degrees, roughness, xyz.data());
+    return pack_encodings(num_loops, [&](int i, Encoder* encoder) {
+        int begin = i * num_vertices;
+        S2Loop(xyz_points(xyz.data(), begin, begin + num_vertices), S2Debug::DISABLE).Encode(encoder);
+    }, out_bytes, out_offsets);
+}
+
+int s2c_generate_polygons_encoded(S2CGenerator* generator, int num_polygons, int num_vertices,
+                                  int nesting_depth, double radius_degrees, double roughness,
+                                  char** out_bytes, int64_t** out_offsets) {
+    if (out_bytes) *out_bytes = nullptr;
+    if (out_offsets) *out_offsets = nullptr;
+    if (!generator || !out_bytes || !out_offsets ||
+        !valid_ring_args(num_polygons, num_vertices, nesting_depth, radius_degrees, roughness)) {
+        return 0;
+    }
+
+    std::vector<double> xyz(3 * static_cast<size_t>(num_polygons) * nesting_depth * num_vertices);
+    generate_rings(generator, num_polygons, num_vertices, nesting_depth, radius_degrees, roughness, xyz.data());
+    return pack_encodings(num_polygons, [&](int i, Encoder* encoder) {
+        std::vector<std::unique_ptr<S2Loop>> loops;
+        for (int k = 0; k < nesting_depth; ++k) {
+            int begin = (i * nesting_depth + k) * num_vertices;
+            loops.push_back(std::make_unique<S2Loop>(xyz_points(xyz.data(), begin, begin + num_vertices),
+                                                     S2Debug::DISABLE));
+        }
+        S2Polygon polygon;
+        polygon.set_s2debug_override(S2Debug::DISABLE);
+        polygon.InitOriented(std::move(loops));
+        polygon.Encode(encoder);
+    }, out_bytes, out_offsets);
+}
+
+// S2CArena functions
+S2CArena* s2c_arena_new(size_t block_size) {
+    auto* arena = new S2CArena;
+    arena->block_size = block_size > 0 ? block_size : 64 * 1024;
+    return arena;
+}
+
+void s2c_arena_reset(S2CArena* arena) {
+    if (!arena) return;
+    for (auto it = arena->destructors.rbegin(); it != arena->destructors.rend(); ++it) {
+        it->second(it->first);
+    }
+    arena->destructors.clear();
+    arena->current = 0;
+    arena->offset = 0;
+    arena->bytes_used = 0;
+}
+
+void s2c_arena_destroy(S2CArena* arena) {
+    s2c_arena_reset(arena);
+    delete arena;
+}
+
+size_t s2c_arena_bytes_used(const S2CArena* arena) {
+    return arena ? arena->bytes_used : 0;
+}
+
+size_t s2c_arena_bytes_reserved(const S2CArena* arena) {
+    if (!arena) return 0;
+    size_t total = 0;
+    for (const auto& block : arena->blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+// Arena variants of constructors and accessors
+S2CPoint* s2c_point_new_arena(S2CArena* arena, double x, double y, double z) {
+    if (!arena) return nullptr;
+    return arena_new<S2CPoint>(arena, S2Point(x, y, z));
+}
+
+S2CPoint* s2c_point_from_latlng_arena(S2CArena* arena, const S2CLatLng* latlng) {
+    if (!arena || !latlng) return nullptr;
+    return arena_new<S2CPoint>(arena, latlng->latlng.ToPoint());
+}
+
+S2CPoint* s2c_point_normalize_arena(S2CArena* arena, const S2CPoint* point) {
+    if (!arena || !point) return nullptr;
+    return arena_new<S2CPoint>(arena, point->point.Normalize());
+}
+
+S2CLatLng* s2c_latlng_from_degrees_arena(S2CArena* arena, double lat_degrees, double lng_degrees) {
+    if (!arena) return nullptr;
+    return arena_new<S2CLatLng>(arena, S2LatLng::FromDegrees(lat_degrees, lng_degrees));
+}
+
+S2CLatLng* s2c_latlng_from_radians_arena(S2CArena* arena, double lat_radians, double lng_radians) {
+    if (!arena) return nullptr;
+    return arena_new<S2CLatLng>(arena, S2LatLng::FromRadians(lat_radians, lng_radians));
+}
+
+S2CLatLng* s2c_latlng_from_point_arena(S2CArena* arena, const S2CPoint* point) {
+    if (!arena || !point) return nullptr;
+    return arena_new<S2CLatLng>(arena, S2LatLng(point->point));
+}
+
+S2CPoint* s2c_latlng_to_point_arena(S2CArena* arena, const S2CLatLng* latlng) {
+    if (!arena || !latlng) return nullptr;
+    return arena_new<S2CPoint>(arena, latlng->latlng.ToPoint());
+}
+
+S1CAngle* s2c_latlng_get_distance_arena(S2CArena* arena, const S2CLatLng* a, const S2CLatLng* b) {
+    if (!arena || !a || !b) return nullptr;
+    return arena_new<S1CAngle>(arena, a->latlng.GetDistance(b->latlng));
+}
+
+S1CAngle* s1c_angle_from_radians_arena(S2CArena* arena, double radians) {
+    if (!arena) return nullptr;
+    return arena_new<S1CAngle>(arena, S1Angle::Radians(radians));
+}
+
+S1CAngle* s1c_angle_from_degrees_arena(S2CArena* arena, double degrees) {
+    if (!arena) return nullptr;
+    return arena_new<S1CAngle>(arena, S1Angle::Degrees(degrees));
+}
+
+S2CCellId* s2c_cellid_new_arena(S2CArena* arena, uint64_t id) {
+    if (!arena) return nullptr;
+    return arena_new<S2CCellId>(arena, S2CellId(id));
+}
+
+S2CCellId* s2c_cellid_from_latlng_arena(S2CArena* arena, const S2CLatLng* latlng) {
+    if (!arena || !latlng) return nullptr;
+    return arena_new<S2CCellId>(arena, S2CellId(latlng->latlng));
+}
+
+S2CCellId* s2c_cellid_from_point_arena(S2CArena* arena, const S2CPoint* point) {
+    if (!arena || !point) return nullptr;
+    return arena_new<S2CCellId>(arena, S2CellId(point->point));
+}
+
+S2CCellId* s2c_cellid_parent_arena(S2CArena* arena, const S2CCellId* cellid, int level) {
+    if (!arena || !cellid || level < 0 || level > 30) return nullptr;
+    return arena_new<S2CCellId>(arena, cellid->cellid.parent(level));
+}
+
+S2CLatLng* s2c_cellid_to_latlng_arena(S2CArena* arena, const S2CCellId* cellid) {
+    if (!arena || !cellid) return nullptr;
+    return arena_new<S2CLatLng>(arena, cellid->cellid.ToLatLng());
+}
+
+S2CPoint* s2c_cellid_to_point_arena(S2CArena* arena, const S2CCellId* cellid) {
+    if (!arena || !cellid) return nullptr;
+    return arena_new<S2CPoint>(arena, cellid->cellid.ToPoint());
+}
+
+S2CCell* s2c_cell_new_arena(S2CArena* arena, const S2CCellId* cellid) {
+    if (!arena || !cellid) return nullptr;
+    return arena_new<S2CCell>(arena, S2Cell(cellid->cellid));
+}
+
+S2CPoint* s2c_cell_get_vertex_arena(S2CArena* arena, const S2CCell* cell, int k) {
+    if (!arena || !cell || k < 0 || k > 3) return nullptr;
+    return arena_new<S2CPoint>(arena, cell->cell.GetVertex(k));
+}
+
+S2CCap* s2c_cap_from_center_angle_arena(S2CArena* arena, const S2CPoint* center, const S1CAngle* angle) {
+    if (!arena || !center || !angle) return nullptr;
+    return arena_new<S2CCap>(arena, S2Cap(center->point, angle->angle));
+}
+
+S2CLatLngRect* s2c_latlngrect_new_from_latlng_arena(S2CArena* arena, const S2CLatLng* lo, const S2CLatLng* hi) {
+    if (!arena || !lo || !hi) return nullptr;
+    return arena_new<S2CLatLngRect>(arena, S2LatLngRect(lo->latlng, hi->latlng));
+}
+
+// Object pool statistics
+bool s2c_object_pools_enabled(void) {
+#ifdef S2C_ENABLE_OBJECT_POOLS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void s2c_object_pool_stats(S2CPoolType type, uint64_t* hits, uint64_t* misses) {
+    if (hits) *hits = 0;
+    if (misses) *misses = 0;
+#ifdef S2C_ENABLE_OBJECT_POOLS
+    switch (type) {
+        case S2C_POOL_POINT: ObjectPool<S2CPoint>::Stats(hits, misses); break;
+        case S2C_POOL_LATLNG: ObjectPool<S2CLatLng>::Stats(hits, misses); break;
+        case S2C_POOL_CELLID: ObjectPool<S2CCellId>::Stats(hits, misses); break;
+        case S2C_POOL_CLOSEST_EDGE_RESULT: ObjectPool<S2CClosestEdgeResult>::Stats(hits, misses); break;
+        case S2C_POOL_CROSSING_EDGE_PAIR: ObjectPool<S2CCrossingEdgePair>::Stats(hits, misses); break;
+    }
+#else
+    (void)type;
+#endif
+}
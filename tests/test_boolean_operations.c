@@ -290,6 +290,73 @@ int test_boolean_operations_with_options() {
     return 0;
 }
 
+int test_winding_operation_overlapping_loops() {
+    printf("Testing S2WindingOperation on overlapping loops...\n");
+    
+    // Three overlapping squares passed as flat xyz loops
+    double coords[][2] = {{0, 0}, {0, 10}, {10, 10}, {10, 0},
+                          {5, 5}, {5, 15}, {15, 15}, {15, 5},
+                          {2, 2}, {2, 12}, {12, 12}, {12, 2}};
+    double xyz[36];
+    for (int i = 0; i < 12; i++) {
+        S2CLatLng* latlng = s2c_latlng_from_degrees(coords[i][0], coords[i][1]);
+        S2CPoint* point = s2c_latlng_to_point(latlng);
+        s2c_point_get_coords(point, &xyz[3 * i], &xyz[3 * i + 1], &xyz[3 * i + 2]);
+        s2c_point_destroy(point);
+        s2c_latlng_destroy(latlng);
+    }
+    int loop_offsets[] = {0, 4, 8, 12};
+    
+    // NON_ZERO flattens the loops into their union
+    S2CPolygon* flattened = s2c_polygon_new();
+    S2CPolygonLayer* layer = s2c_polygon_layer_new(flattened);
+    S2CWindingOperation* op = s2c_winding_operation_new(s2c_polygon_layer_as_builder_layer(layer));
+    ASSERT(op != NULL);
+    s2c_winding_operation_add_loops(op, xyz, loop_offsets, 3);
+    
+    S2CError error;
+    ASSERT(s2c_winding_operation_build(op, NULL, 0, S2C_WINDING_RULE_NON_ZERO, &error));
+    ASSERT(error.ok);
+    s2c_free_string(error.text);
+    
+    // Compare against sequential unions
+    S2CPolygon* polygons[3];
+    for (int i = 0; i < 3; i++) {
+        polygons[i] = create_polygon_from_coords(&coords[4 * i], 4);
+    }
+    S2CPolygon* union_result = s2c_polygon_new();
+    s2c_polygon_init_to_union(union_result, polygons, 3);
+    
+    double flattened_area = s2c_polygon_get_area(flattened);
+    double union_area = s2c_polygon_get_area(union_result);
+    printf("  Winding area: %.6f, union area: %.6f\n", flattened_area, union_area);
+    ASSERT(fabs(flattened_area - union_area) < 1e-9);
+    
+    // Declaring the reference winding as -1 makes POSITIVE keep areas covered twice
+    S2CPolygon* overlap = s2c_polygon_new();
+    S2CPolygonLayer* overlap_layer = s2c_polygon_layer_new(overlap);
+    S2CWindingOperation* overlap_op = s2c_winding_operation_new(s2c_polygon_layer_as_builder_layer(overlap_layer));
+    s2c_winding_operation_add_loops(overlap_op, xyz, loop_offsets, 3);
+    ASSERT(s2c_winding_operation_build(overlap_op, NULL, -1, S2C_WINDING_RULE_POSITIVE, &error));
+    s2c_free_string(error.text);
+    double overlap_area = s2c_polygon_get_area(overlap);
+    printf("  Area covered at least twice: %.6f\n", overlap_area);
+    ASSERT(overlap_area > 0);
+    ASSERT(overlap_area < union_area);
+    
+    // Clean up
+    for (int i = 0; i < 3; i++) {
+        s2c_polygon_destroy(polygons[i]);
+    }
+    s2c_polygon_destroy(union_result);
+    s2c_polygon_destroy(flattened);
+    s2c_polygon_destroy(overlap);
+    s2c_winding_operation_destroy(op);
+    s2c_winding_operation_destroy(overlap_op);
+    
+    return 0;
+}
+
 int main() {
     printf("Running S2BooleanOperation tests...\n\n");
     
@@ -297,6 +364,7 @@ int main() {
     if (test_boolean_intersection_with_shape_indexes() != 0) return 1;
     if (test_boolean_difference_with_shape_indexes() != 0) return 1;
     if (test_boolean_operations_with_options() != 0) return 1;
+    if (test_winding_operation_overlapping_loops() != 0) return 1;
     
     printf("\nAll S2BooleanOperation tests passed!\n");
     printf("\nSummary: Successfully demonstrated boolean operations with shape indexes:\n");
@@ -304,6 +372,7 @@ int main() {
     printf("- INTERSECTION to find overlapping regions\n");
     printf("- DIFFERENCE to subtract one coverage from another\n");
     printf("- Custom options for polygon models and snapping\n");
+    printf("- Winding-rule flattening of overlapping loops\n");
     
     return 0;
 }
\ No newline at end of file
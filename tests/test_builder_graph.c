@@ -0,0 +1,302 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "s2c.h"
+#include "test_fixtures.h"
+
+#define ASSERT(condition) \
+    if (!(condition)) { \
+        printf("Assertion failed: %s (line %d)\n", #condition, __LINE__); \
+        return 1; \
+    }
+
+typedef struct {
+    int calls;
+    int num_vertices;
+    int num_edges;
+    int num_input_edge_ids;
+    bool edges_in_range;
+} GraphStats;
+
+static bool collect_graph_stats(const double* vertices, int num_vertices,
+                                const int32_t* edges, int num_edges,
+                                const int32_t* input_edge_offsets, const int32_t* input_edge_ids,
+                                void* user_data) {
+    GraphStats* stats = (GraphStats*)user_data;
+    (void)vertices;
+    (void)input_edge_ids;
+    stats->calls++;
+    stats->num_vertices = num_vertices;
+    stats->num_edges = num_edges;
+    stats->num_input_edge_ids = input_edge_offsets[num_edges];
+    stats->edges_in_range = true;
+    for (int i = 0; i < 2 * num_edges; i++) {
+        if (edges[i] < 0 || edges[i] >= num_vertices) stats->edges_in_range = false;
+    }
+    return true;
+}
+
+static bool reject_graph(const double* vertices, int num_vertices,
+                         const int32_t* edges, int num_edges,
+                         const int32_t* input_edge_offsets, const int32_t* input_edge_ids,
+                         void* user_data) {
+    (void)vertices; (void)num_vertices; (void)edges; (void)num_edges;
+    (void)input_edge_offsets; (void)input_edge_ids; (void)user_data;
+    return false;
+}
+
+// Fills xyz with unit vectors for the given lat/lng degree pairs
+static void fill_xyz(double coords[][2], int n, double* xyz) {
+    for (int i = 0; i < n; i++) {
+        S2CLatLng* latlng = s2c_latlng_from_degrees(coords[i][0], coords[i][1]);
+        S2CPoint* point = s2c_latlng_to_point(latlng);
+        s2c_point_get_coords(point, &xyz[3 * i], &xyz[3 * i + 1], &xyz[3 * i + 2]);
+        s2c_point_destroy(point);
+        s2c_latlng_destroy(latlng);
+    }
+}
+
+int test_graph_layer_bulk_edges() {
+    printf("Testing S2GraphLayer with bulk edge input...\n");
+
+    // One open chain (2 edges) followed by one loop (3 edges)
+    double coords[][2] = {{0, 0}, {0, 1}, {0, 2},
+                          {10, 10}, {10, 11}, {11, 10}};
+    double xyz[18];
+    fill_xyz(coords, 6, xyz);
+    int chain_offsets[] = {0, 3};
+    int loop_offsets[] = {3, 6};
+
+    GraphStats stats;
+    memset(&stats, 0, sizeof(stats));
+
+    S2CBuilder* builder = s2c_builder_new();
+    S2CGraphLayer* layer = s2c_graph_layer_new(collect_graph_stats, &stats);
+    ASSERT(layer != NULL);
+    s2c_builder_start_layer(builder, s2c_graph_layer_as_builder_layer(layer));
+    s2c_builder_add_edges(builder, xyz, chain_offsets, 1);
+    s2c_builder_add_loops(builder, xyz, loop_offsets, 1);
+
+    S2CError error = {true, NULL};
+    ASSERT(s2c_builder_build(builder, &error));
+    // Success reports a zero code without allocating a message
+    ASSERT(error.text == NULL);
+    ASSERT(s2c_error_code(&error) == S2C_ERROR_OK);
+    ASSERT(s2c_last_error_code() == S2C_ERROR_OK);
+    ASSERT(s2c_last_error_message()[0] == '\0');
+
+    printf("  Graph has %d vertices and %d edges\n", stats.num_vertices, stats.num_edges);
+    ASSERT(stats.calls == 1);
+    ASSERT(stats.num_vertices == 6);
+    ASSERT(stats.num_edges == 5);
+    ASSERT(stats.num_input_edge_ids == 5);
+    ASSERT(stats.edges_in_range);
+
+    s2c_graph_layer_destroy(layer);
+    s2c_builder_destroy(builder);
+    return 0;
+}
+
+int test_graph_layer_undirected_merge() {
+    printf("Testing S2GraphLayer with merged undirected edges...\n");
+
+    // The same chain added twice collapses into a single set of edges
+    double coords[][2] = {{0, 0}, {0, 1}, {1, 1}};
+    double xyz[9];
+    fill_xyz(coords, 3, xyz);
+    int chain_offsets[] = {0, 3};
+
+    GraphStats stats;
+    memset(&stats, 0, sizeof(stats));
+
+    S2CBuilder* builder = s2c_builder_new();
+    S2CGraphLayer* layer = s2c_graph_layer_new_with_options(
+        collect_graph_stats, &stats, S2C_EDGE_TYPE_UNDIRECTED,
+        S2C_DEGENERATE_EDGES_DISCARD, S2C_DUPLICATE_EDGES_MERGE, S2C_SIBLING_PAIRS_KEEP);
+    s2c_builder_start_layer(builder, s2c_graph_layer_as_builder_layer(layer));
+    s2c_builder_add_edges(builder, xyz, chain_offsets, 1);
+    s2c_builder_add_edges(builder, xyz, chain_offsets, 1);
+
+    S2CError error = {true, NULL};
+    ASSERT(s2c_builder_build(builder, &error));
+    s2c_free_string(error.text);
+
+    // Undirected edges are stored in both directions
+    ASSERT(stats.num_vertices == 3);
+    ASSERT(stats.num_edges == 4);
+    ASSERT(stats.edges_in_range);
+
+    s2c_graph_layer_destroy(layer);
+    s2c_builder_destroy(builder);
+    return 0;
+}
+
+int test_graph_layer_callback_failure() {
+    printf("Testing S2GraphLayer callback failure...\n");
+
+    double coords[][2] = {{0, 0}, {0, 1}};
+    double xyz[6];
+    fill_xyz(coords, 2, xyz);
+    int chain_offsets[] = {0, 2};
+
+    S2CBuilder* builder = s2c_builder_new();
+    S2CGraphLayer* layer = s2c_graph_layer_new(reject_graph, NULL);
+    s2c_builder_start_layer(builder, s2c_graph_layer_as_builder_layer(layer));
+    s2c_builder_add_edges(builder, xyz, chain_offsets, 1);
+
+    S2CError error = {true, NULL};
+    ASSERT(!s2c_builder_build(builder, &error));
+    ASSERT(!error.ok);
+    ASSERT(s2c_error_code(&error) == S2C_ERROR_FAILED_PRECONDITION);
+    ASSERT(s2c_last_error_code() == S2C_ERROR_FAILED_PRECONDITION);
+    ASSERT(error.text != NULL);
+    ASSERT(strcmp(error.text, s2c_last_error_message()) == 0);
+    s2c_free_string(error.text);
+
+    s2c_graph_layer_destroy(layer);
+    s2c_builder_destroy(builder);
+    return 0;
+}
+
+int test_build_cancellation() {
+    printf("Testing cancellable builds...\n");
+
+    double coords[][2] = {{0, 0}, {0, 1}, {1, 1}};
+    double xyz[9];
+    fill_xyz(coords, 3, xyz);
+    int chain_offsets[] = {0, 3};
+
+    GraphStats stats;
+    memset(&stats, 0, sizeof(stats));
+    S2CBuilder* builder = s2c_builder_new();
+    S2CGraphLayer* layer = s2c_graph_layer_new(collect_graph_stats, &stats);
+    s2c_builder_start_layer(builder, s2c_graph_layer_as_builder_layer(layer));
+    s2c_builder_add_edges(builder, xyz, chain_offsets, 1);
+
+    // An expired token fails the build before it starts
+    S2CCancelToken* token = s2c_cancel_token_new();
+    ASSERT(!s2c_cancel_token_is_cancelled(token));
+    s2c_cancel_token_set_deadline(token, 0);
+    ASSERT(s2c_cancel_token_is_cancelled(token));
+
+    S2CError error = {true, NULL};
+    ASSERT(!s2c_builder_build_cancellable(builder, token, &error));
+    ASSERT(s2c_error_code(&error) == S2C_ERROR_CANCELLED);
+    ASSERT(stats.calls == 0);
+    s2c_free_string(error.text);
+
+    s2c_cancel_token_reset(token);
+    s2c_cancel_token_set_deadline(token, 60000);
+    ASSERT(s2c_builder_build_cancellable(builder, token, &error));
+    ASSERT(error.text == NULL);
+    ASSERT(stats.calls == 1);
+
+    // Index builds take the same tokens
+    S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+    ASSERT(s2c_mutable_shape_index_force_build_cancellable(index, token, &error));
+    s2c_cancel_token_cancel(token);
+    ASSERT(!s2c_mutable_shape_index_force_build_cancellable(index, token, &error));
+    ASSERT(s2c_error_code(&error) == S2C_ERROR_CANCELLED);
+    s2c_free_string(error.text);
+
+    s2c_mutable_shape_index_destroy(index);
+    s2c_cancel_token_destroy(token);
+    s2c_graph_layer_destroy(layer);
+    s2c_builder_destroy(builder);
+    return 0;
+}
+
+int test_operation_cancellation() {
+    printf("Testing cancellable boolean and buffer operations...\n");
+
+    S2CPolygon* a = fixture_generated_polygon(1, 64);
+    S2CPolygon* b = fixture_generated_polygon(2, 64);
+    ASSERT(a && b && s2c_polygon_num_loops(a) == 1 && s2c_polygon_num_loops(b) == 1);
+    S2CCancelToken* token = s2c_cancel_token_new();
+    s2c_cancel_token_set_deadline(token, 60000);
+
+    // Without a token, and with one that has not expired, the builds complete
+    for (int with_token = 0; with_token < 2; with_token++) {
+        S2CPolygon* merged = s2c_polygon_new();
+        ASSERT(fixture_union(a, b, NULL, with_token ? token : NULL, merged) == S2C_ERROR_OK);
+        ASSERT(s2c_polygon_get_area(merged) > s2c_polygon_get_area(a));
+        s2c_polygon_destroy(merged);
+
+        S2CPolygon* buffered = s2c_polygon_new();
+        ASSERT(fixture_buffer(a, NULL, with_token ? token : NULL, buffered) == S2C_ERROR_OK);
+        ASSERT(s2c_polygon_get_area(buffered) > s2c_polygon_get_area(a));
+        s2c_polygon_destroy(buffered);
+    }
+
+    // A cancelled token stops both before they start
+    s2c_cancel_token_cancel(token);
+    S2CPolygon* unused = s2c_polygon_new();
+    ASSERT(fixture_union(a, b, NULL, token, unused) == S2C_ERROR_CANCELLED);
+    ASSERT(fixture_buffer(a, NULL, token, unused) == S2C_ERROR_CANCELLED);
+    s2c_polygon_destroy(unused);
+
+    s2c_cancel_token_destroy(token);
+    s2c_polygon_destroy(a);
+    s2c_polygon_destroy(b);
+    return 0;
+}
+
+int test_cancellation_during_build() {
+    printf("Testing cancellation of running builds...\n");
+
+    // Inputs large enough that each build runs far past a 5 ms deadline; the
+    // token is checked from S2's memory tracker callback while it runs
+    double* xyz;
+    int* loop_offsets;
+    S2CGenerator* generator = s2c_generator_new(5);
+    ASSERT(s2c_generate_loops(generator, 16, 16384, 1.0, 0.5, &xyz, &loop_offsets) == 16);
+    s2c_generator_destroy(generator);
+
+    GraphStats stats;
+    memset(&stats, 0, sizeof(stats));
+    S2CBuilder* builder = s2c_builder_new();
+    S2CGraphLayer* layer = s2c_graph_layer_new(collect_graph_stats, &stats);
+    s2c_builder_start_layer(builder, s2c_graph_layer_as_builder_layer(layer));
+    s2c_builder_add_loops(builder, xyz, loop_offsets, 16);
+
+    S2CCancelToken* token = s2c_cancel_token_new();
+    s2c_cancel_token_set_deadline(token, 5);
+    S2CError error = {true, NULL};
+    ASSERT(!s2c_builder_build_cancellable(builder, token, &error));
+    ASSERT(s2c_error_code(&error) == S2C_ERROR_CANCELLED);
+    ASSERT(stats.calls == 0);
+    s2c_free_string(error.text);
+    s2c_graph_layer_destroy(layer);
+    s2c_builder_destroy(builder);
+
+    S2CPolygon* a = fixture_generated_polygon(1, 200000);
+    S2CPolygon* b = fixture_generated_polygon(2, 200000);
+    ASSERT(a && b && s2c_polygon_num_loops(a) == 1 && s2c_polygon_num_loops(b) == 1);
+    S2CPolygon* unused = s2c_polygon_new();
+    s2c_cancel_token_reset(token);
+    s2c_cancel_token_set_deadline(token, 5);
+    ASSERT(fixture_union(a, b, NULL, token, unused) == S2C_ERROR_CANCELLED);
+    s2c_polygon_destroy(unused);
+
+    s2c_cancel_token_destroy(token);
+    s2c_polygon_destroy(a);
+    s2c_polygon_destroy(b);
+    s2c_free_buffer(xyz);
+    s2c_free_buffer(loop_offsets);
+    return 0;
+}
+
+int main() {
+    printf("Running S2Builder graph layer tests...\n\n");
+    
+    if (test_graph_layer_bulk_edges() != 0) return 1;
+    if (test_graph_layer_undirected_merge() != 0) return 1;
+    if (test_graph_layer_callback_failure() != 0) return 1;
+    if (test_build_cancellation() != 0) return 1;
+    if (test_operation_cancellation() != 0) return 1;
+    if (test_cancellation_during_build() != 0) return 1;
+    
+    printf("\nAll S2Builder graph layer tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,313 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "s2c.h"
+
+#define ASSERT(condition) \
+    if (!(condition)) { \
+        printf("Assertion failed: %s (line %d)\n", #condition, __LINE__); \
+        return 1; \
+    }
+
+#define NUM_IDS 64
+
+// Fills ids with cells at varying levels spread over all faces
+static void fill_ids(uint64_t* ids, int n) {
+    for (int i = 0; i < n; i++) {
+        S2CLatLng* latlng = s2c_latlng_from_degrees(-80.0 + 160.0 * i / n, -179.0 + 358.0 * i / n);
+        S2CCellId* leaf = s2c_cellid_from_latlng(latlng);
+        S2CCellId* cell = s2c_cellid_parent(leaf, 10 + i % 21);
+        ids[i] = s2c_cellid_id(cell);
+        s2c_cellid_destroy(cell);
+        s2c_cellid_destroy(leaf);
+        s2c_latlng_destroy(latlng);
+    }
+}
+
+int test_cellid_hierarchy_kernels() {
+    printf("Testing S2CellId array kernels...\n");
+
+    uint64_t ids[NUM_IDS], out[NUM_IDS];
+    uint8_t small[NUM_IDS];
+    fill_ids(ids, NUM_IDS);
+
+    s2c_cellid_parent_batch(ids, NUM_IDS, 10, out);
+    for (int i = 0; i < NUM_IDS; i++) {
+        S2CCellId* id = s2c_cellid_new(ids[i]);
+        S2CCellId* parent = s2c_cellid_parent(id, 10);
+        ASSERT(out[i] == s2c_cellid_id(parent));
+        s2c_cellid_destroy(parent);
+        s2c_cellid_destroy(id);
+    }
+
+    s2c_cellid_range_min_batch(ids, NUM_IDS, out);
+    for (int i = 0; i < NUM_IDS; i++) {
+        S2CCellId* id = s2c_cellid_new(ids[i]);
+        S2CCellId* range_min = s2c_cellid_range_min(id);
+        ASSERT(out[i] == s2c_cellid_id(range_min));
+        s2c_cellid_destroy(range_min);
+        s2c_cellid_destroy(id);
+    }
+    s2c_cellid_range_max_batch(ids, NUM_IDS, out);
+    for (int i = 0; i < NUM_IDS; i++) {
+        S2CCellId* id = s2c_cellid_new(ids[i]);
+        S2CCellId* range_max = s2c_cellid_range_max(id);
+        ASSERT(out[i] == s2c_cellid_id(range_max));
+        s2c_cellid_destroy(range_max);
+        s2c_cellid_destroy(id);
+    }
+
+    // child_begin/end at the next level match the handle-based versions
+    uint64_t parents[NUM_IDS];
+    s2c_cellid_parent_batch(ids, NUM_IDS, 9, parents);
+    s2c_cellid_child_begin_batch(parents, NUM_IDS, 10, out);
+    for (int i = 0; i < NUM_IDS; i++) {
+        S2CCellId* id = s2c_cellid_new(parents[i]);
+        S2CCellId* begin = s2c_cellid_child_begin(id);
+        ASSERT(out[i] == s2c_cellid_id(begin));
+        s2c_cellid_destroy(begin);
+        s2c_cellid_destroy(id);
+    }
+    s2c_cellid_child_end_batch(parents, NUM_IDS, 10, out);
+    for (int i = 0; i < NUM_IDS; i++) {
+        S2CCellId* id = s2c_cellid_new(parents[i]);
+        S2CCellId* end = s2c_cellid_child_end(id);
+        ASSERT(out[i] == s2c_cellid_id(end));
+        s2c_cellid_destroy(end);
+        s2c_cellid_destroy(id);
+    }
+
+    s2c_cellid_level_batch(ids, NUM_IDS, small);
+    for (int i = 0; i < NUM_IDS; i++) {
+        ASSERT(small[i] == 10 + i % 21);
+    }
+    s2c_cellid_face_batch(ids, NUM_IDS, small);
+    for (int i = 0; i < NUM_IDS; i++) {
+        S2CCellId* id = s2c_cellid_new(ids[i]);
+        ASSERT(small[i] == s2c_cellid_face(id));
+        s2c_cellid_destroy(id);
+    }
+
+    // Parents contain their descendants but not the other way around
+    s2c_cellid_contains_batch(parents, ids, NUM_IDS, small);
+    for (int i = 0; i < NUM_IDS; i++) {
+        ASSERT(small[i] == 1);
+    }
+    s2c_cellid_contains_batch(ids, parents, NUM_IDS, small);
+    for (int i = 0; i < NUM_IDS; i++) {
+        ASSERT(small[i] == 0);
+    }
+
+    // In-place operation
+    memcpy(out, ids, sizeof(out));
+    s2c_cellid_parent_batch(out, NUM_IDS, 9, out);
+    ASSERT(memcmp(out, parents, sizeof(out)) == 0);
+    return 0;
+}
+
+int test_cellid_token_batches() {
+    printf("Testing batch token encode/decode...\n");
+
+    uint64_t ids[NUM_IDS], decoded[NUM_IDS];
+    fill_ids(ids, NUM_IDS);
+    ids[0] = 0;  // S2CellId::None() encodes as "X"
+
+    char bytes[16 * NUM_IDS];
+    int64_t offsets[NUM_IDS + 1];
+    int64_t total = s2c_cellid_to_tokens_packed(ids, NUM_IDS, bytes, offsets, 4);
+    ASSERT(total == offsets[NUM_IDS]);
+    for (int i = 0; i < NUM_IDS; i++) {
+        S2CCellId* id = s2c_cellid_new(ids[i]);
+        char* token = s2c_cellid_to_token(id);
+        ASSERT((int64_t)strlen(token) == offsets[i + 1] - offsets[i]);
+        ASSERT(memcmp(token, bytes + offsets[i], strlen(token)) == 0);
+        s2c_free_string(token);
+        s2c_cellid_destroy(id);
+    }
+
+    ASSERT(s2c_cellid_from_tokens_packed(bytes, offsets, NUM_IDS, decoded, 1) == NUM_IDS - 1);
+    ASSERT(memcmp(ids, decoded, sizeof(ids)) == 0);
+
+    // Fixed stride with room for a terminating NUL
+    char fixed[17 * NUM_IDS];
+    ASSERT(s2c_cellid_to_tokens_fixed(ids, NUM_IDS, fixed, 17, 0));
+    ASSERT(strcmp(&fixed[0], "X") == 0);
+    for (int i = 1; i < NUM_IDS; i++) {
+        ASSERT((int64_t)strlen(&fixed[17 * i]) == offsets[i + 1] - offsets[i]);
+    }
+    memset(decoded, 0xFF, sizeof(decoded));
+    ASSERT(s2c_cellid_from_tokens_fixed(fixed, NUM_IDS, 17, decoded, 3) == NUM_IDS - 1);
+    ASSERT(memcmp(ids, decoded, sizeof(ids)) == 0);
+    ASSERT(!s2c_cellid_to_tokens_fixed(ids, NUM_IDS, fixed, 8, 1));
+
+    // Uppercase is accepted; bad characters and overlong tokens decode to 0
+    const char* tokens = "89C259" "89c2g9" "89c2590000000000f";
+    int64_t token_offsets[] = {0, 6, 12, 29};
+    uint64_t out[3];
+    ASSERT(s2c_cellid_from_tokens_packed(tokens, token_offsets, 3, out, 1) == 1);
+    S2CCellId* expected = s2c_cellid_from_token("89c259");
+    ASSERT(out[0] == s2c_cellid_id(expected));
+    ASSERT(out[1] == 0 && out[2] == 0);
+    s2c_cellid_destroy(expected);
+    return 0;
+}
+
+int test_cellid_neighbor_buffers() {
+    printf("Testing neighbor enumeration into caller buffers...\n");
+
+    S2CLatLng* latlng = s2c_latlng_from_degrees(20.0, 10.0);
+    S2CCellId* leaf = s2c_cellid_from_latlng(latlng);
+    S2CCellId* cell = s2c_cellid_parent(leaf, 12);
+    uint64_t id = s2c_cellid_id(cell);
+
+    uint64_t edge[4];
+    s2c_cellid_edge_neighbor_ids(id, edge);
+    S2CCellId* handles[4];
+    s2c_cellid_get_edge_neighbors(cell, handles);
+    for (int i = 0; i < 4; i++) {
+        ASSERT(edge[i] == s2c_cellid_id(handles[i]));
+        s2c_cellid_destroy(handles[i]);
+    }
+
+    // An invalid id overwrites stale output with S2CellId::None()
+    s2c_cellid_edge_neighbor_ids(0, edge);
+    for (int i = 0; i < 4; i++) {
+        ASSERT(edge[i] == 0);
+    }
+
+    // A short buffer reports the full count
+    uint64_t nbrs[64];
+    int needed = s2c_cellid_all_neighbor_ids(id, 13, nbrs, 2);
+    ASSERT(needed > 2);
+    ASSERT(s2c_cellid_all_neighbor_ids(id, 13, nbrs, 64) == needed);
+    S2CCellId** appended = NULL;
+    int count = 0;
+    s2c_cellid_append_all_neighbors(cell, 13, &appended, &count);
+    ASSERT(count == needed);
+    for (int i = 0; i < count; i++) {
+        ASSERT(nbrs[i] == s2c_cellid_id(appended[i]));
+    }
+    s2c_free_cellid_array(appended, count);
+
+    ASSERT(s2c_cellid_vertex_neighbor_ids(id, 11, nbrs, 64) == 4);
+    ASSERT(s2c_cellid_all_neighbor_ids(id, 11, nbrs, 64) == 0);
+
+    s2c_cellid_destroy(cell);
+    s2c_cellid_destroy(leaf);
+    s2c_latlng_destroy(latlng);
+    return 0;
+}
+
+int test_cellid_k_ring_batch() {
+    printf("Testing batch k-ring...\n");
+
+    uint64_t ids[NUM_IDS];
+    fill_ids(ids, NUM_IDS);
+    s2c_cellid_parent_batch(ids, NUM_IDS, 10, ids);
+    ids[1] = ids[0];  // Duplicate inputs get their own ring
+
+    uint64_t* rings = NULL;
+    int64_t* offsets = NULL;
+    int64_t total = s2c_cellid_k_ring_batch(ids, NUM_IDS, 1, 4, &rings, &offsets);
+    ASSERT(total == offsets[NUM_IDS]);
+    for (int i = 0; i < NUM_IDS; i++) {
+        int64_t size = offsets[i + 1] - offsets[i];
+        // 9 cells, or 8 next to a cube vertex
+        ASSERT(size == 9 || size == 8);
+        int has_self = 0;
+        for (int64_t j = offsets[i]; j < offsets[i + 1]; j++) {
+            if (j > offsets[i]) ASSERT(rings[j - 1] < rings[j]);
+            has_self |= rings[j] == ids[i];
+        }
+        ASSERT(has_self);
+    }
+    ASSERT(offsets[1] - offsets[0] == offsets[2] - offsets[1]);
+    ASSERT(memcmp(&rings[offsets[0]], &rings[offsets[1]], sizeof(uint64_t) * (offsets[1] - offsets[0])) == 0);
+    s2c_free_buffer(rings);
+    s2c_free_buffer(offsets);
+
+    // k = 2 away from face edges is a 5x5 block; k = 0 is the cell itself
+    S2CLatLng* latlng = s2c_latlng_from_degrees(0.0, 0.0);
+    S2CCellId* leaf = s2c_cellid_from_latlng(latlng);
+    S2CCellId* cell = s2c_cellid_parent(leaf, 8);
+    uint64_t center = s2c_cellid_id(cell);
+    ASSERT(s2c_cellid_k_ring_batch(&center, 1, 2, 1, &rings, &offsets) == 25);
+    s2c_free_buffer(rings);
+    s2c_free_buffer(offsets);
+    ASSERT(s2c_cellid_k_ring_batch(&center, 1, 0, 1, &rings, &offsets) == 1);
+    ASSERT(rings[0] == center);
+    s2c_free_buffer(rings);
+    s2c_free_buffer(offsets);
+
+    s2c_cellid_destroy(cell);
+    s2c_cellid_destroy(leaf);
+    s2c_latlng_destroy(latlng);
+    return 0;
+}
+
+static uint64_t leaf_id_of(const double* xyz) {
+    S2CPoint* point = s2c_point_new(xyz[0], xyz[1], xyz[2]);
+    S2CCellId* cell = s2c_cellid_from_point(point);
+    uint64_t id = s2c_cellid_id(cell);
+    s2c_cellid_destroy(cell);
+    s2c_point_destroy(point);
+    return id;
+}
+
+int test_sort_points_by_cellid() {
+    printf("Testing Hilbert-order sorting and partitioning of points...\n");
+
+    enum { kNumPoints = 1000, kNumParts = 7 };
+    double* xyz = (double*)malloc(sizeof(double) * 3 * kNumPoints);
+    srand(42);
+    for (int i = 0; i < kNumPoints; i++) {
+        S2CLatLng* latlng = s2c_latlng_from_degrees(rand() % 17900 / 100.0 - 89.5, rand() % 35900 / 100.0 - 179.5);
+        S2CPoint* point = s2c_latlng_to_point(latlng);
+        s2c_point_get_coords(point, &xyz[3 * i], &xyz[3 * i + 1], &xyz[3 * i + 2]);
+        s2c_point_destroy(point);
+        s2c_latlng_destroy(latlng);
+    }
+
+    uint32_t* perm = (uint32_t*)malloc(sizeof(uint32_t) * kNumPoints);
+    ASSERT(s2c_sort_points_by_cellid(xyz, kNumPoints, perm));
+    int* seen = (int*)calloc(kNumPoints, sizeof(int));
+    uint64_t prev = 0;
+    for (int i = 0; i < kNumPoints; i++) {
+        ASSERT(perm[i] < kNumPoints && !seen[perm[i]]);
+        seen[perm[i]] = 1;
+        uint64_t id = leaf_id_of(&xyz[3 * perm[i]]);
+        ASSERT(id >= prev);
+        prev = id;
+    }
+
+    size_t offsets[kNumParts + 1];
+    uint64_t ranges[2 * kNumParts];
+    ASSERT(s2c_partition_points_by_cellid(xyz, kNumPoints, kNumParts, perm, offsets, ranges));
+    ASSERT(offsets[0] == 0 && offsets[kNumParts] == kNumPoints);
+    for (int p = 0; p < kNumParts; p++) {
+        size_t size = offsets[p + 1] - offsets[p];
+        ASSERT(size == kNumPoints / kNumParts || size == kNumPoints / kNumParts + 1);
+        ASSERT(ranges[2 * p] == leaf_id_of(&xyz[3 * perm[offsets[p]]]));
+        ASSERT(ranges[2 * p + 1] == leaf_id_of(&xyz[3 * perm[offsets[p + 1] - 1]]));
+        if (p > 0) ASSERT(ranges[2 * p - 1] <= ranges[2 * p]);
+    }
+
+    free(seen);
+    free(perm);
+    free(xyz);
+    return 0;
+}
+
+int main() {
+    printf("Running S2CellId tests...\n\n");
+    
+    if (test_cellid_hierarchy_kernels() != 0) return 1;
+    if (test_cellid_token_batches() != 0) return 1;
+    if (test_cellid_neighbor_buffers() != 0) return 1;
+    if (test_cellid_k_ring_batch() != 0) return 1;
+    if (test_sort_points_by_cellid() != 0) return 1;
+    
+    printf("\nAll S2CellId tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "s2c.h"
+
+#define ASSERT(condition) \
+    if (!(condition)) { \
+        printf("Assertion failed: %s (line %d)\n", #condition, __LINE__); \
+        return 1; \
+    }
+
+static uint64_t cell_id_from_degrees(double lat, double lng, int level) {
+    S2CLatLng* latlng = s2c_latlng_from_degrees(lat, lng);
+    S2CCellId* leaf = s2c_cellid_from_latlng(latlng);
+    S2CCellId* cell = s2c_cellid_parent(leaf, level);
+    uint64_t id = s2c_cellid_id(cell);
+    s2c_cellid_destroy(cell);
+    s2c_cellid_destroy(leaf);
+    s2c_latlng_destroy(latlng);
+    return id;
+}
+
+// Fills ids with the four children of the given cell
+static void fill_children(uint64_t parent, uint64_t* ids) {
+    S2CCellId* cell = s2c_cellid_new(parent);
+    for (int k = 0; k < 4; k++) {
+        S2CCellId* child = s2c_cellid_child(cell, k);
+        ids[k] = s2c_cellid_id(child);
+        s2c_cellid_destroy(child);
+    }
+    s2c_cellid_destroy(cell);
+}
+
+int test_cellunion_normalize_in_place() {
+    printf("Testing in-place normalization of id arrays...\n");
+
+    uint64_t parent = cell_id_from_degrees(10.0, 20.0, 8);
+    uint64_t other = cell_id_from_degrees(-30.0, 40.0, 12);
+
+    // Four shuffled siblings, a duplicate and a descendant of one sibling
+    uint64_t ids[7];
+    fill_children(parent, ids);
+    uint64_t tmp = ids[0]; ids[0] = ids[3]; ids[3] = tmp;
+    ids[4] = other;
+    ids[5] = other;
+    uint64_t grandchildren[4];
+    fill_children(ids[1], grandchildren);
+    ids[6] = grandchildren[2];
+
+    int n = s2c_cellunion_normalize_in_place(ids, 7);
+    ASSERT(n == 2);
+    ASSERT(ids[0] < ids[1]);
+    ASSERT((ids[0] == parent && ids[1] == other) || (ids[0] == other && ids[1] == parent));
+
+    // The result matches the handle-based union
+    uint64_t copy[7];
+    fill_children(parent, copy);
+    copy[4] = other;
+    S2CCellUnion* cell_union = s2c_cellunion_new_from_ids(copy, 5);
+    int num_cells = 0;
+    const uint64_t* stored = s2c_cellunion_cell_ids(cell_union, &num_cells);
+    ASSERT(num_cells == n);
+    ASSERT(memcmp(stored, ids, sizeof(uint64_t) * n) == 0);
+    s2c_cellunion_destroy(cell_union);
+
+    ASSERT(s2c_cellunion_normalize_in_place(NULL, 3) == 0);
+    return 0;
+}
+
+int test_cellunion_zero_copy_ids() {
+    printf("Testing zero-copy cell id access...\n");
+
+    int n = 100;
+    uint64_t* ids = (uint64_t*)malloc(sizeof(uint64_t) * n);
+    for (int i = 0; i < n; i++) {
+        ids[i] = cell_id_from_degrees(-50.0 + i, -170.0 + 3.0 * i, 15);
+    }
+    S2CCellUnion* cell_union = s2c_cellunion_new_from_ids_take(ids, n);
+    ASSERT(cell_union != NULL);
+    ASSERT(s2c_cellunion_is_normalized(cell_union));
+
+    int num_cells = 0;
+    const uint64_t* view = s2c_cellunion_cell_ids(cell_union, &num_cells);
+    ASSERT(num_cells == n);
+    for (int i = 0; i < num_cells; i++) {
+        S2CCellId* id = s2c_cellunion_cell_id(cell_union, i);
+        ASSERT(view[i] == s2c_cellid_id(id));
+        s2c_cellid_destroy(id);
+    }
+    // Repeated calls return the same storage
+    ASSERT(s2c_cellunion_cell_ids(cell_union, NULL) == view);
+
+    s2c_cellunion_destroy(cell_union);
+    return 0;
+}
+
+int test_cellunion_set_operations() {
+    printf("Testing S2CellUnion set operations into reusable unions...\n");
+
+    uint64_t a_ids[4], b_ids[2];
+    uint64_t parent = cell_id_from_degrees(10.0, 20.0, 8);
+    fill_children(parent, a_ids);
+    S2CCellUnion* a = s2c_cellunion_new_from_ids(a_ids, 2);        // children 0 and 1
+    b_ids[0] = a_ids[2];
+    b_ids[1] = a_ids[3];
+    S2CCellUnion* b = s2c_cellunion_new_from_ids(b_ids, 2);        // children 2 and 3
+
+    S2CCellUnion* out = s2c_cellunion_new();
+    s2c_cellunion_union_into(a, b, out);
+    int n = 0;
+    const uint64_t* ids = s2c_cellunion_cell_ids(out, &n);
+    ASSERT(n == 1 && ids[0] == parent);
+
+    S2CCellUnion* both = s2c_cellunion_union(a, b);
+    ASSERT(s2c_cellunion_num_cells(both) == 1);
+
+    s2c_cellunion_intersection_into(both, a, out);
+    ASSERT(s2c_cellunion_num_cells(out) == 2);
+    s2c_cellunion_difference_into(both, a, out);
+    ids = s2c_cellunion_cell_ids(out, &n);
+    ASSERT(n == 2 && ids[0] == a_ids[2] && ids[1] == a_ids[3]);
+
+    // Output aliasing an input
+    s2c_cellunion_union_into(out, a, out);
+    ASSERT(s2c_cellunion_num_cells(out) == 1);
+
+    ASSERT(s2c_cellunion_leaf_cells_covered(out) == (uint64_t)1 << (2 * (30 - 8)));
+
+    // The cell plus its 8 neighbors at the same level
+    s2c_cellunion_expand_level(out, 8);
+    ASSERT(s2c_cellunion_leaf_cells_covered(out) == 9 * ((uint64_t)1 << (2 * (30 - 8))));
+    uint64_t before = s2c_cellunion_leaf_cells_covered(a);
+    s2c_cellunion_expand_radius(a, 0.01, 4);
+    ASSERT(s2c_cellunion_leaf_cells_covered(a) > before);
+
+    s2c_cellunion_destroy(out);
+    s2c_cellunion_destroy(both);
+    s2c_cellunion_destroy(a);
+    s2c_cellunion_destroy(b);
+    return 0;
+}
+
+int test_cellunion_leaf_ranges() {
+    printf("Testing S2CellUnion construction from leaf ranges...\n");
+
+    uint64_t parent = cell_id_from_degrees(-5.0, 100.0, 12);
+    S2CCellId* cell = s2c_cellid_new(parent);
+    S2CCellId* min_id = s2c_cellid_range_min(cell);
+    S2CCellId* max_id = s2c_cellid_range_max(cell);
+
+    S2CCellUnion* cell_union = s2c_cellunion_from_min_max(s2c_cellid_id(min_id), s2c_cellid_id(max_id));
+    int n = 0;
+    const uint64_t* ids = s2c_cellunion_cell_ids(cell_union, &n);
+    ASSERT(n == 1 && ids[0] == parent);
+
+    // [min, max.next()) as begin/end is the same cell
+    ASSERT(s2c_cellunion_init_from_begin_end(cell_union, s2c_cellid_id(min_id), s2c_cellid_id(max_id) + 2));
+    ASSERT(s2c_cellunion_leaf_cells_covered(cell_union) == (uint64_t)1 << (2 * (30 - 12)));
+    ASSERT(s2c_cellunion_init_from_min_max(cell_union, s2c_cellid_id(min_id), s2c_cellid_id(min_id)));
+    ASSERT(s2c_cellunion_leaf_cells_covered(cell_union) == 1);
+
+    // Non-leaf bounds are rejected
+    ASSERT(s2c_cellunion_from_min_max(parent, parent) == NULL);
+    ASSERT(!s2c_cellunion_init_from_min_max(cell_union, s2c_cellid_id(max_id), s2c_cellid_id(min_id)));
+
+    s2c_cellunion_destroy(cell_union);
+    s2c_cellid_destroy(min_id);
+    s2c_cellid_destroy(max_id);
+    s2c_cellid_destroy(cell);
+    return 0;
+}
+
+int test_cellunion_contains_ids() {
+    printf("Testing batch membership with a merge sweep...\n");
+
+    uint64_t union_ids[3];
+    union_ids[0] = cell_id_from_degrees(0.0, 0.0, 6);
+    union_ids[1] = cell_id_from_degrees(45.0, 45.0, 10);
+    union_ids[2] = cell_id_from_degrees(-45.0, -120.0, 4);
+    S2CCellUnion* cell_union = s2c_cellunion_new_from_ids(union_ids, 3);
+
+    uint64_t queries[6];
+    queries[0] = cell_id_from_degrees(0.0, 0.0, 20);       // inside
+    queries[1] = cell_id_from_degrees(45.0, 45.0, 30);     // inside
+    queries[2] = cell_id_from_degrees(-45.0, -120.0, 3);   // parent of a union cell
+    queries[3] = cell_id_from_degrees(80.0, 10.0, 15);     // outside
+    queries[4] = cell_id_from_degrees(-45.0, -120.0, 4);   // equal to a union cell
+    queries[5] = cell_id_from_degrees(10.0, -60.0, 30);    // outside
+    int expected[6] = {1, 1, 0, 0, 1, 0};
+
+    // Unsorted input
+    uint8_t out[6];
+    int count = s2c_cellunion_contains_ids(cell_union, queries, 6, out);
+    ASSERT(count == 3);
+    for (int i = 0; i < 6; i++) {
+        ASSERT(out[i] == expected[i]);
+    }
+
+    // Sorted input gives the same answers per id
+    for (int i = 0; i < 6; i++) {
+        for (int j = i + 1; j < 6; j++) {
+            if (queries[j] < queries[i]) {
+                uint64_t q = queries[i]; queries[i] = queries[j]; queries[j] = q;
+                int e = expected[i]; expected[i] = expected[j]; expected[j] = e;
+            }
+        }
+    }
+    ASSERT(s2c_cellunion_contains_ids(cell_union, queries, 6, out) == 3);
+    for (int i = 0; i < 6; i++) {
+        S2CCellId* id = s2c_cellid_new(queries[i]);
+        ASSERT(out[i] == expected[i]);
+        ASSERT(out[i] == s2c_cellunion_contains_cellid(cell_union, id));
+        s2c_cellid_destroy(id);
+    }
+
+    s2c_cellunion_destroy(cell_union);
+    return 0;
+}
+
+int main() {
+    printf("Running S2CellUnion tests...\n\n");
+    
+    if (test_cellunion_normalize_in_place() != 0) return 1;
+    if (test_cellunion_zero_copy_ids() != 0) return 1;
+    if (test_cellunion_set_operations() != 0) return 1;
+    if (test_cellunion_leaf_ranges() != 0) return 1;
+    if (test_cellunion_contains_ids() != 0) return 1;
+    
+    printf("\nAll S2CellUnion tests passed!\n");
+    return 0;
+}
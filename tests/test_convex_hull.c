@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "s2c.h"
+
+#define ASSERT(condition) \
+    if (!(condition)) { \
+        printf("Assertion failed: %s (line %d)\n", #condition, __LINE__); \
+        return 1; \
+    }
+
+static void latlng_to_xyz(double lat, double lng, double* xyz) {
+    S2CLatLng* latlng = s2c_latlng_from_degrees(lat, lng);
+    S2CPoint* point = s2c_latlng_to_point(latlng);
+    s2c_point_get_coords(point, &xyz[0], &xyz[1], &xyz[2]);
+    s2c_point_destroy(point);
+    s2c_latlng_destroy(latlng);
+}
+
+int test_convex_hull_of_points() {
+    printf("Testing S2ConvexHullQuery with bulk points...\n");
+    
+    // Square corners plus an interior point that must not appear in the hull
+    double coords[][2] = {{0, 0}, {0, 1}, {1, 1}, {1, 0}, {0.5, 0.5}};
+    double xyz[15];
+    for (int i = 0; i < 5; i++) {
+        latlng_to_xyz(coords[i][0], coords[i][1], &xyz[3 * i]);
+    }
+    
+    S2CConvexHullQuery* query = s2c_convex_hull_query_new();
+    s2c_convex_hull_query_add_points(query, xyz, 5);
+    S2CLoop* hull = s2c_convex_hull_query_get_convex_hull(query);
+    ASSERT(hull != NULL);
+    printf("  Hull has %d vertices\n", s2c_loop_num_vertices(hull));
+    ASSERT(s2c_loop_num_vertices(hull) == 4);
+    
+    S2CPoint* center = s2c_point_new(xyz[12], xyz[13], xyz[14]);
+    ASSERT(s2c_loop_contains(hull, center));
+    
+    S2CCap* cap = s2c_convex_hull_query_get_cap_bound(query);
+    ASSERT(s2c_cap_contains(cap, center));
+    
+    s2c_cap_destroy(cap);
+    s2c_point_destroy(center);
+    s2c_loop_destroy(hull);
+    s2c_convex_hull_query_destroy(query);
+    return 0;
+}
+
+int test_convex_hull_of_polygon() {
+    printf("Testing S2ConvexHullQuery with a polygon...\n");
+    
+    double coords[][2] = {{0, 0}, {0, 10}, {10, 10}, {10, 0}};
+    S2CPoint* points[4];
+    for (int i = 0; i < 4; i++) {
+        S2CLatLng* latlng = s2c_latlng_from_degrees(coords[i][0], coords[i][1]);
+        points[i] = s2c_latlng_to_point(latlng);
+        s2c_latlng_destroy(latlng);
+    }
+    S2CLoop* loop = s2c_loop_new_from_points((const S2CPoint**)points, 4);
+    S2CPolygon* polygon = s2c_polygon_new_from_loop(loop);
+    
+    S2CConvexHullQuery* query = s2c_convex_hull_query_new();
+    s2c_convex_hull_query_add_polygon(query, polygon);
+    S2CLoop* hull = s2c_convex_hull_query_get_convex_hull(query);
+    ASSERT(fabs(s2c_loop_get_area(hull) - s2c_polygon_get_area(polygon)) < 1e-9);
+    
+    for (int i = 0; i < 4; i++) {
+        s2c_point_destroy(points[i]);
+    }
+    s2c_loop_destroy(hull);
+    s2c_loop_destroy(loop);
+    s2c_polygon_destroy(polygon);
+    s2c_convex_hull_query_destroy(query);
+    return 0;
+}
+
+int test_convex_hull_batch() {
+    printf("Testing batch convex hulls grouped by id...\n");
+    
+    // Group 7: triangle near the origin, group 9: square further east
+    double coords[][2] = {{0, 0}, {0, 1}, {1, 0},
+                          {0, 20}, {0, 21}, {1, 21}, {1, 20}};
+    int64_t group_ids[] = {7, 7, 7, 9, 9, 9, 9};
+    double xyz[21];
+    for (int i = 0; i < 7; i++) {
+        latlng_to_xyz(coords[i][0], coords[i][1], &xyz[3 * i]);
+    }
+    
+    S2CLoop** hulls = NULL;
+    int64_t* hull_ids = NULL;
+    int count = s2c_convex_hull_batch(xyz, group_ids, 7, &hulls, &hull_ids);
+    ASSERT(count == 2);
+    ASSERT(hull_ids[0] == 7);
+    ASSERT(hull_ids[1] == 9);
+    ASSERT(s2c_loop_num_vertices(hulls[0]) == 3);
+    ASSERT(s2c_loop_num_vertices(hulls[1]) == 4);
+    
+    s2c_free_loop_array(hulls, count);
+    s2c_free_buffer(hull_ids);
+    return 0;
+}
+
+int main() {
+    printf("Running S2ConvexHullQuery tests...\n\n");
+    
+    if (test_convex_hull_of_points() != 0) return 1;
+    if (test_convex_hull_of_polygon() != 0) return 1;
+    if (test_convex_hull_batch() != 0) return 1;
+    
+    printf("\nAll S2ConvexHullQuery tests passed!\n");
+    return 0;
+}
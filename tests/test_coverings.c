@@ -0,0 +1,274 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "s2c.h"
+
+#define ASSERT(condition) \
+    if (!(condition)) { \
+        printf("Assertion failed: %s (line %d)\n", #condition, __LINE__); \
+        return 1; \
+    }
+
+static S2CCap* make_cap(double lat, double lng, double radius_degrees) {
+    S2CLatLng* latlng = s2c_latlng_from_degrees(lat, lng);
+    S2CPoint* center = s2c_latlng_to_point(latlng);
+    S1CAngle* radius = s1c_angle_from_degrees(radius_degrees);
+    S2CCap* cap = s2c_cap_from_center_angle(center, radius);
+    s1c_angle_destroy(radius);
+    s2c_point_destroy(center);
+    s2c_latlng_destroy(latlng);
+    return cap;
+}
+
+static S2CLatLngRect* make_rect(double lat_lo, double lng_lo, double lat_hi, double lng_hi) {
+    S2CLatLng* lo = s2c_latlng_from_degrees(lat_lo, lng_lo);
+    S2CLatLng* hi = s2c_latlng_from_degrees(lat_hi, lng_hi);
+    S2CLatLngRect* rect = s2c_latlngrect_new_from_latlng(lo, hi);
+    s2c_latlng_destroy(lo);
+    s2c_latlng_destroy(hi);
+    return rect;
+}
+
+// Checks ids[0..n) against the handle-based covering of one region
+static int same_covering(const uint64_t* ids, int64_t n, S2CCellId** cells, int count) {
+    if (n != count) return 0;
+    for (int i = 0; i < count; i++) {
+        if (ids[i] != s2c_cellid_id(cells[i])) return 0;
+    }
+    return 1;
+}
+
+int test_coverings_batch() {
+    printf("Testing batch coverings of mixed regions...\n");
+
+    enum { kNumRegions = 200 };
+    S2CCap* caps[kNumRegions / 2];
+    S2CLatLngRect* rects[kNumRegions / 2];
+    S2CRegionRef regions[kNumRegions];
+    for (int i = 0; i < kNumRegions / 2; i++) {
+        caps[i] = make_cap(-60.0 + 0.6 * i, -170.0 + 1.7 * i, 0.5 + 0.01 * i);
+        rects[i] = make_rect(-40.0 + 0.4 * i, 10.0 + 0.5 * i, -39.0 + 0.4 * i, 11.5 + 0.5 * i);
+        regions[2 * i].type = S2C_REGION_CAP;
+        regions[2 * i].region = caps[i];
+        regions[2 * i + 1].type = S2C_REGION_RECT;
+        regions[2 * i + 1].region = rects[i];
+    }
+
+    S2CRegionCoverer* coverer = s2c_regioncoverer_new();
+    s2c_regioncoverer_set_max_cells(coverer, 12);
+
+    uint64_t* ids = NULL;
+    int64_t* offsets = NULL;
+    int64_t total = s2c_regioncoverer_get_coverings_batch(coverer, regions, kNumRegions, false, 4, &ids, &offsets);
+    printf("  Covered %d regions with %lld cells\n", kNumRegions, (long long)total);
+    ASSERT(total > kNumRegions);
+    ASSERT(offsets[0] == 0);
+    ASSERT(offsets[kNumRegions] == total);
+
+    // Every region matches its single-region covering
+    for (int i = 0; i < kNumRegions; i++) {
+        S2CCellId** cells = NULL;
+        int count = 0;
+        if (i % 2 == 0) {
+            s2c_regioncoverer_get_covering_cap(coverer, caps[i / 2], &cells, &count);
+        } else {
+            s2c_regioncoverer_get_covering_rect(coverer, rects[i / 2], &cells, &count);
+        }
+        ASSERT(same_covering(&ids[offsets[i]], offsets[i + 1] - offsets[i], cells, count));
+        s2c_free_cellid_array(cells, count);
+    }
+
+    // Single-threaded execution produces the identical buffer
+    uint64_t* serial_ids = NULL;
+    int64_t* serial_offsets = NULL;
+    ASSERT(s2c_regioncoverer_get_coverings_batch(coverer, regions, kNumRegions, false, 1,
+                                                 &serial_ids, &serial_offsets) == total);
+    ASSERT(memcmp(ids, serial_ids, sizeof(uint64_t) * total) == 0);
+    ASSERT(memcmp(offsets, serial_offsets, sizeof(int64_t) * (kNumRegions + 1)) == 0);
+    s2c_free_buffer(serial_ids);
+    s2c_free_buffer(serial_offsets);
+    s2c_free_buffer(ids);
+    s2c_free_buffer(offsets);
+
+    // Interior coverings use the same concatenated layout
+    total = s2c_regioncoverer_get_coverings_batch(coverer, regions, kNumRegions, true, 0, &ids, &offsets);
+    ASSERT(offsets[kNumRegions] == total);
+    s2c_free_buffer(ids);
+    s2c_free_buffer(offsets);
+
+    s2c_regioncoverer_destroy(coverer);
+    for (int i = 0; i < kNumRegions / 2; i++) {
+        s2c_cap_destroy(caps[i]);
+        s2c_latlngrect_destroy(rects[i]);
+    }
+    return 0;
+}
+
+int test_fixed_level_coverings() {
+    printf("Testing fixed-level cap and rect coverings...\n");
+
+    S2CCap* cap = make_cap(37.0, -122.0, 0.3);
+    S2CLatLngRect* rect = make_rect(10.0, 20.0, 10.5, 21.0);
+    S2CRegionCoverer* coverer = s2c_regioncoverer_new();
+    s2c_regioncoverer_set_fixed_level(coverer, 10);
+
+    uint64_t* ids = NULL;
+    int64_t n = s2c_regioncoverer_fixed_level_covering_cap(cap, 10, &ids);
+    printf("  Level 10 cap covering has %lld cells\n", (long long)n);
+    ASSERT(n > 1);
+    for (int64_t i = 1; i < n; i++) {
+        ASSERT(ids[i - 1] < ids[i]);
+    }
+    S2CCellId** cells = NULL;
+    int count = 0;
+    s2c_regioncoverer_get_covering_cap(coverer, cap, &cells, &count);
+    ASSERT(same_covering(ids, n, cells, count));
+    s2c_free_cellid_array(cells, count);
+    s2c_free_buffer(ids);
+
+    n = s2c_regioncoverer_fixed_level_covering_rect(rect, 10, &ids);
+    ASSERT(n > 1);
+    s2c_regioncoverer_get_covering_rect(coverer, rect, &cells, &count);
+    ASSERT(same_covering(ids, n, cells, count));
+    s2c_free_cellid_array(cells, count);
+    s2c_free_buffer(ids);
+
+    // Level 0 returns whole faces
+    n = s2c_regioncoverer_fixed_level_covering_cap(cap, 0, &ids);
+    ASSERT(n == 1);
+    s2c_free_buffer(ids);
+    ASSERT(s2c_regioncoverer_fixed_level_covering_cap(cap, 31, &ids) == 0);
+    ASSERT(ids == NULL);
+
+    s2c_regioncoverer_destroy(coverer);
+    s2c_cap_destroy(cap);
+    s2c_latlngrect_destroy(rect);
+    return 0;
+}
+
+int test_shape_index_coverings() {
+    printf("Testing shape index and buffered coverings...\n");
+
+    // A short route along the equator
+    S2CLatLng* a = s2c_latlng_from_degrees(0.0, 0.0);
+    S2CLatLng* b = s2c_latlng_from_degrees(0.0, 0.1);
+    const S2CLatLng* vertices[] = {a, b};
+    S2CPolyline* route = s2c_polyline_new_from_latlngs(vertices, 2);
+    S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+    s2c_mutable_shape_index_add_polyline(index, route);
+
+    S2CRegionCoverer* coverer = s2c_regioncoverer_new();
+    s2c_regioncoverer_set_max_cells(coverer, 16);
+
+    uint64_t* ids = NULL;
+    int64_t n = s2c_regioncoverer_get_covering_shape_index(coverer, index, false, &ids);
+    ASSERT(n > 0 && n <= 16);
+    s2c_free_buffer(ids);
+
+    // Within 200 m of the route; every cell stays near the equator
+    double radius = s2c_earth_to_radians_meters(200.0);
+    n = s2c_regioncoverer_get_covering_buffered_shape_index(coverer, index, radius, &ids);
+    printf("  Buffered route covering has %lld cells\n", (long long)n);
+    ASSERT(n > 0 && n <= 16);
+    for (int64_t i = 0; i < n; i++) {
+        S2CCellId* id = s2c_cellid_new(ids[i]);
+        S2CLatLng* center = s2c_cellid_to_latlng(id);
+        ASSERT(fabs(s2c_latlng_lat_degrees(center)) < 1.0);
+        s2c_latlng_destroy(center);
+        s2c_cellid_destroy(id);
+    }
+
+    // The covering contains the whole buffered region: the route itself and
+    // points up to 150 m either side of it
+    S2CCellUnion* buffered = s2c_cellunion_new_from_ids(ids, (int)n);
+    double offset_degrees = s2c_earth_to_radians_meters(150.0) * 180.0 / 3.14159265358979;
+    for (int i = 0; i <= 10; i++) {
+        double lng = 0.01 * i;
+        for (int side = -1; side <= 1; side++) {
+            S2CLatLng* latlng = s2c_latlng_from_degrees(side * offset_degrees, lng);
+            S2CPoint* point = s2c_latlng_to_point(latlng);
+            ASSERT(s2c_cellunion_contains(buffered, point));
+            s2c_point_destroy(point);
+            s2c_latlng_destroy(latlng);
+        }
+    }
+    s2c_cellunion_destroy(buffered);
+    s2c_free_buffer(ids);
+
+    ASSERT(s2c_regioncoverer_get_covering_buffered_shape_index(coverer, index, -1.0, &ids) == 0);
+
+    s2c_regioncoverer_destroy(coverer);
+    s2c_mutable_shape_index_destroy(index);
+    s2c_polyline_destroy(route);
+    s2c_latlng_destroy(a);
+    s2c_latlng_destroy(b);
+    return 0;
+}
+
+int test_covering_cache() {
+    printf("Testing covering cache...\n");
+
+    S2CCap* cap = make_cap(48.85, 2.35, 0.2);
+    S2CCap* same_cap = make_cap(48.85, 2.35, 0.2);
+    S2CLatLngRect* rect = make_rect(51.0, -1.0, 52.0, 0.5);
+    S2CRegionRef cap_ref = {S2C_REGION_CAP, cap};
+    S2CRegionRef same_cap_ref = {S2C_REGION_CAP, same_cap};
+    S2CRegionRef rect_ref = {S2C_REGION_RECT, rect};
+
+    S2CRegionCoverer* coverer = s2c_regioncoverer_new();
+    S2CCoveringCache* cache = s2c_covering_cache_new(1);
+
+    S2CCovering* first = s2c_covering_cache_get(cache, coverer, &cap_ref, false);
+    ASSERT(first != NULL);
+    ASSERT(s2c_covering_size(first) > 0);
+    ASSERT(s2c_covering_cache_misses(cache) == 1);
+
+    // An equal region hits the cache and shares the stored ids
+    S2CCovering* second = s2c_covering_cache_get(cache, coverer, &same_cap_ref, false);
+    ASSERT(s2c_covering_cache_hits(cache) == 1);
+    ASSERT(s2c_covering_ids(second) == s2c_covering_ids(first));
+
+    // Different options are a different key
+    s2c_regioncoverer_set_max_cells(coverer, 20);
+    S2CCovering* third = s2c_covering_cache_get(cache, coverer, &cap_ref, false);
+    ASSERT(s2c_covering_cache_misses(cache) == 2);
+
+    // Evicted coverings stay readable while held
+    S2CCovering* fourth = s2c_covering_cache_get(cache, coverer, &rect_ref, false);
+    ASSERT(s2c_covering_cache_size(cache) == 1);
+    ASSERT(s2c_covering_size(first) == s2c_covering_size(second));
+    S2CCellId** cells = NULL;
+    int count = 0;
+    s2c_regioncoverer_get_covering_rect(coverer, rect, &cells, &count);
+    ASSERT(same_covering(s2c_covering_ids(fourth), s2c_covering_size(fourth), cells, count));
+    s2c_free_cellid_array(cells, count);
+
+    s2c_covering_destroy(first);
+    s2c_covering_destroy(second);
+    s2c_covering_destroy(third);
+    s2c_covering_destroy(fourth);
+
+    s2c_covering_cache_clear(cache);
+    ASSERT(s2c_covering_cache_size(cache) == 0);
+    ASSERT(s2c_covering_cache_hits(cache) == 0);
+
+    s2c_covering_cache_destroy(cache);
+    s2c_regioncoverer_destroy(coverer);
+    s2c_cap_destroy(cap);
+    s2c_cap_destroy(same_cap);
+    s2c_latlngrect_destroy(rect);
+    return 0;
+}
+
+int main() {
+    printf("Running covering tests...\n\n");
+    
+    if (test_coverings_batch() != 0) return 1;
+    if (test_fixed_level_coverings() != 0) return 1;
+    if (test_shape_index_coverings() != 0) return 1;
+    if (test_covering_cache() != 0) return 1;
+    
+    printf("\nAll covering tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,85 @@
+#ifndef S2C_TEST_FIXTURES_H
+#define S2C_TEST_FIXTURES_H
+
+// Geometry and operation helpers shared by the C tests. Everything is static,
+// so each test executable compiles its own copy.
+
+#include <stdlib.h>
+#include "s2c.h"
+
+// One fractal loop of num_vertices vertices within a degree of (0, 0), as a
+// single-loop polygon built from the generator's xyz output; NULL on failure
+static S2CPolygon* fixture_generated_polygon(uint64_t seed, int num_vertices) {
+    S2CGenerator* generator = s2c_generator_new(seed);
+    s2c_generator_set_region(generator, 0, 0, 1);
+    double* xyz = NULL;
+    int* offsets = NULL;
+    S2CPolygon* polygon = NULL;
+    if (s2c_generate_loops(generator, 1, num_vertices, 1.0, 0.5, &xyz, &offsets) == 1) {
+        int count = offsets[1] - offsets[0];
+        S2CPoint** points = malloc(sizeof(S2CPoint*) * count);
+        for (int i = 0; i < count; i++) {
+            const double* p = xyz + 3 * (offsets[0] + i);
+            points[i] = s2c_point_new(p[0], p[1], p[2]);
+        }
+        S2CLoop* loop = s2c_loop_new_from_points((const S2CPoint**)points, count);
+        if (loop) {
+            polygon = s2c_polygon_new_from_loop(loop);
+            s2c_loop_destroy(loop);
+        }
+        for (int i = 0; i < count; i++) s2c_point_destroy(points[i]);
+        free(points);
+    }
+    s2c_free_buffer(xyz);
+    s2c_free_buffer(offsets);
+    s2c_generator_destroy(generator);
+    return polygon;
+}
+
+// Collapses a build's result and error into one code; -1 if they disagree
+static int fixture_error_code(bool ok, S2CError* error) {
+    int code = ok == error->ok ? s2c_error_code(error) : -1;
+    s2c_free_string(error->text);
+    return code;
+}
+
+// Unions a and b into result. tracker and token are attached unless NULL, and
+// a token selects the cancellable build; returns the error code
+static int fixture_union(S2CPolygon* a, S2CPolygon* b, S2CMemoryTracker* tracker,
+                         const S2CCancelToken* token, S2CPolygon* result) {
+    S2CMutableShapeIndex* index_a = s2c_mutable_shape_index_new();
+    S2CMutableShapeIndex* index_b = s2c_mutable_shape_index_new();
+    s2c_mutable_shape_index_add_polygon(index_a, a);
+    s2c_mutable_shape_index_add_polygon(index_b, b);
+    S2CBuilderLayer* layer = s2c_polygon_layer_as_builder_layer(s2c_polygon_layer_new(result));
+    S2CBooleanOperation* op = s2c_boolean_operation_new(S2C_BOOLEAN_OP_UNION, layer);
+    if (tracker) s2c_boolean_operation_set_memory_tracker(op, tracker);
+    S2CError error = {true, NULL, S2C_ERROR_OK};
+    bool ok = token ? s2c_boolean_operation_build_mutable_indexes_cancellable(op, index_a, index_b, token, &error)
+                    : s2c_boolean_operation_build_mutable_indexes(op, index_a, index_b, &error);
+    s2c_boolean_operation_destroy(op);
+    s2c_builder_layer_destroy(layer);
+    s2c_mutable_shape_index_destroy(index_a);
+    s2c_mutable_shape_index_destroy(index_b);
+    return fixture_error_code(ok, &error);
+}
+
+// Buffers polygon by 0.1 degrees (about 10 km) into result, with tracker and
+// token as for fixture_union; returns the error code
+static int fixture_buffer(S2CPolygon* polygon, S2CMemoryTracker* tracker,
+                          const S2CCancelToken* token, S2CPolygon* result) {
+    S2CBuilderLayer* layer = s2c_polygon_layer_as_builder_layer(s2c_polygon_layer_new(result));
+    S1CAngle* radius = s1c_angle_from_degrees(0.1);
+    S2CBufferOperation* op = s2c_buffer_operation_new_with_options(layer, radius, 0.01);
+    if (tracker) s2c_buffer_operation_set_memory_tracker(op, tracker);
+    s2c_buffer_operation_add_polygon(op, polygon);
+    S2CError error = {true, NULL, S2C_ERROR_OK};
+    bool ok = token ? s2c_buffer_operation_build_cancellable(op, token, &error)
+                    : s2c_buffer_operation_build(op, &error);
+    s2c_buffer_operation_destroy(op);
+    s1c_angle_destroy(radius);
+    s2c_builder_layer_destroy(layer);
+    return fixture_error_code(ok, &error);
+}
+
+#endif  // S2C_TEST_FIXTURES_H
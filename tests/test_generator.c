@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "s2c.h"
+
+#define ASSERT(condition) \
+    if (!(condition)) { \
+        printf("Assertion failed: %s (line %d)\n", #condition, __LINE__); \
+        return 1; \
+    }
+
+static double angle_between(const double* a, const double* b) {
+    double cx = a[1] * b[2] - a[2] * b[1];
+    double cy = a[2] * b[0] - a[0] * b[2];
+    double cz = a[0] * b[1] - a[1] * b[0];
+    return atan2(sqrt(cx * cx + cy * cy + cz * cz), a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+}
+
+int test_generator_determinism() {
+    printf("Testing generator determinism...\n");
+
+    S2CGenerator* a = s2c_generator_new(42);
+    S2CGenerator* b = s2c_generator_new(42);
+    double* xyz_a;
+    double* xyz_b;
+    ASSERT(s2c_generate_points(a, 10000, &xyz_a) == 10000);
+    ASSERT(s2c_generate_points(b, 10000, &xyz_b) == 10000);
+    ASSERT(memcmp(xyz_a, xyz_b, sizeof(double) * 3 * 10000) == 0);
+    for (int i = 0; i < 10000; i++) {
+        double norm = sqrt(xyz_a[3 * i] * xyz_a[3 * i] + xyz_a[3 * i + 1] * xyz_a[3 * i + 1] +
+                           xyz_a[3 * i + 2] * xyz_a[3 * i + 2]);
+        ASSERT(fabs(norm - 1.0) < 1e-14);
+    }
+    s2c_free_buffer(xyz_b);
+
+    // Later calls continue the sequence; reseeding restarts it
+    ASSERT(s2c_generate_points(b, 10000, &xyz_b) == 10000);
+    ASSERT(memcmp(xyz_a, xyz_b, sizeof(double) * 3 * 10000) != 0);
+    s2c_free_buffer(xyz_b);
+    s2c_generator_reseed(b, 42);
+    ASSERT(s2c_generate_points(b, 10000, &xyz_b) == 10000);
+    ASSERT(memcmp(xyz_a, xyz_b, sizeof(double) * 3 * 10000) == 0);
+
+    // Invalid arguments produce nothing
+    double* none;
+    int* offsets;
+    ASSERT(s2c_generate_points(a, 0, &none) == 0);
+    ASSERT(none == NULL);
+    ASSERT(s2c_generate_loops(a, 1, 2, 1.0, 0.0, &none, &offsets) == 0);
+    ASSERT(none == NULL && offsets == NULL);
+
+    s2c_free_buffer(xyz_a);
+    s2c_free_buffer(xyz_b);
+    s2c_generator_destroy(a);
+    s2c_generator_destroy(b);
+    return 0;
+}
+
+int test_generator_region_and_clusters() {
+    printf("Testing generator regions and clustering...\n");
+
+    S2CGenerator* generator = s2c_generator_new(7);
+    s2c_generator_set_region(generator, 0, 0, 10);
+    double center[3] = {1, 0, 0};
+    double* xyz;
+    ASSERT(s2c_generate_points(generator, 5000, &xyz) == 5000);
+    double max_angle = 0;
+    for (int i = 0; i < 5000; i++) {
+        double angle = angle_between(center, &xyz[3 * i]);
+        if (angle > max_angle) max_angle = angle;
+    }
+    s2c_free_buffer(xyz);
+    printf("  Farthest point is %.3f degrees from the region center\n", max_angle * 180 / 3.14159265358979);
+    ASSERT(max_angle <= 10.0 * 3.14159265358979 / 180 + 1e-12);
+
+    // Clustered points crowd around a handful of centers
+    s2c_generator_set_clustering(generator, 3, 0.01);
+    ASSERT(s2c_generate_points(generator, 3000, &xyz) == 3000);
+    int num_close = 0;
+    for (int i = 1; i < 3000; i++) {
+        if (angle_between(&xyz[0], &xyz[3 * i]) < 0.001) num_close++;
+    }
+    printf("  %d points share the first point's cluster\n", num_close);
+    ASSERT(num_close > 500);
+
+    s2c_free_buffer(xyz);
+    s2c_generator_destroy(generator);
+    return 0;
+}
+
+int test_generator_polylines() {
+    printf("Testing generated GPS traces...\n");
+
+    S2CGenerator* generator = s2c_generator_new(1);
+    double* xyz;
+    int* offsets;
+    ASSERT(s2c_generate_polylines(generator, 20, 100, 0.01, 0.0001, &xyz, &offsets) == 20);
+    ASSERT(offsets[0] == 0 && offsets[20] == 2000);
+    for (int i = 0; i < 20; i++) {
+        for (int j = offsets[i] + 1; j < offsets[i + 1]; j++) {
+            // Steps are within [0.5, 1.5) of the step length, plus noise
+            ASSERT(angle_between(&xyz[3 * (j - 1)], &xyz[3 * j]) < 0.02 * 3.14159265358979 / 180);
+        }
+    }
+    s2c_free_buffer(xyz);
+    s2c_free_buffer(offsets);
+
+    char* bytes;
+    int64_t* byte_offsets;
+    ASSERT(s2c_generate_polylines_encoded(generator, 5, 50, 0.01, 0.0, &bytes, &byte_offsets) == 5);
+    for (int i = 0; i < 5; i++) {
+        S2CPolyline* polyline = s2c_polyline_new();
+        ASSERT(s2c_polyline_decode(polyline, bytes + byte_offsets[i], byte_offsets[i + 1] - byte_offsets[i]));
+        ASSERT(s2c_polyline_num_vertices(polyline) == 50);
+        s2c_polyline_destroy(polyline);
+    }
+    s2c_free_buffer(bytes);
+    s2c_free_buffer(byte_offsets);
+    s2c_generator_destroy(generator);
+    return 0;
+}
+
+int test_generator_loops() {
+    printf("Testing generated fractal loops...\n");
+
+    S2CGenerator* generator = s2c_generator_new(3);
+    s2c_generator_set_region(generator, 40, -100, 20);
+    char* bytes;
+    int64_t* offsets;
+    enum { kNumLoops = 30 };
+    ASSERT(s2c_generate_loops_encoded(generator, kNumLoops, 256, 0.5, 1.0, &bytes, &offsets) == kNumLoops);
+
+    S2CLoop* loops[kNumLoops];
+    for (int i = 0; i < kNumLoops; i++) {
+        loops[i] = s2c_loop_new();
+        ASSERT(s2c_loop_decode(loops[i], bytes + offsets[i], offsets[i + 1] - offsets[i]));
+        S2CError error = {true, NULL};
+        ASSERT(s2c_loop_is_valid(loops[i], &error));
+        ASSERT(s2c_loop_num_vertices(loops[i]) == 256);
+    }
+
+    // Without overlap the loops are spread out across the region
+    for (int i = 0; i < kNumLoops; i++) {
+        for (int j = i + 1; j < kNumLoops; j++) ASSERT(!s2c_loop_intersects(loops[i], loops[j]));
+    }
+    for (int i = 0; i < kNumLoops; i++) s2c_loop_destroy(loops[i]);
+    s2c_free_buffer(bytes);
+    s2c_free_buffer(offsets);
+
+    // With full overlap each loop lands on an earlier one
+    s2c_generator_set_overlap(generator, 1.0);
+    ASSERT(s2c_generate_loops_encoded(generator, 2, 64, 0.5, 0.0, &bytes, &offsets) == 2);
+    for (int i = 0; i < 2; i++) {
+        loops[i] = s2c_loop_new();
+        ASSERT(s2c_loop_decode(loops[i], bytes + offsets[i], offsets[i + 1] - offsets[i]));
+    }
+    ASSERT(s2c_loop_intersects(loops[0], loops[1]));
+    s2c_loop_destroy(loops[0]);
+    s2c_loop_destroy(loops[1]);
+    s2c_free_buffer(bytes);
+    s2c_free_buffer(offsets);
+    s2c_generator_destroy(generator);
+    return 0;
+}
+
+int test_generator_polygons() {
+    printf("Testing generated nested polygons...\n");
+
+    S2CGenerator* generator = s2c_generator_new(11);
+    double* xyz;
+    int* loop_offsets;
+    int* polygon_offsets;
+    ASSERT(s2c_generate_polygons(generator, 4, 32, 3, 1.0, 0.5, &xyz, &loop_offsets, &polygon_offsets) == 4);
+    ASSERT(polygon_offsets[4] == 12);
+    ASSERT(loop_offsets[12] == 12 * 32);
+    s2c_free_buffer(xyz);
+    s2c_free_buffer(loop_offsets);
+    s2c_free_buffer(polygon_offsets);
+
+    char* bytes;
+    int64_t* offsets;
+    ASSERT(s2c_generate_polygons_encoded(generator, 4, 128, 3, 1.0, 1.0, &bytes, &offsets) == 4);
+    for (int i = 0; i < 4; i++) {
+        S2CPolygon* polygon = s2c_polygon_new();
+        ASSERT(s2c_polygon_decode(polygon, bytes + offsets[i], offsets[i + 1] - offsets[i]));
+        S2CError error = {true, NULL};
+        ASSERT(s2c_polygon_is_valid(polygon, &error));
+        ASSERT(s2c_polygon_num_loops(polygon) == 3);
+        // Re-encoding reproduces the generator's bytes
+        size_t length = 0;
+        char* encoded = s2c_polygon_encode(polygon, &length);
+        ASSERT(encoded != NULL);
+        ASSERT((int64_t)length == offsets[i + 1] - offsets[i]);
+        ASSERT(memcmp(encoded, bytes + offsets[i], length) == 0);
+        s2c_free_buffer(encoded);
+        // Shell, hole, island
+        for (int k = 0; k < 3; k++) {
+            S2CLoop* loop = s2c_polygon_loop(polygon, k);
+            ASSERT(s2c_loop_depth(loop) == k);
+            ASSERT(s2c_loop_is_hole(loop) == (k == 1));
+            s2c_loop_destroy(loop);
+        }
+        s2c_polygon_destroy(polygon);
+    }
+    s2c_free_buffer(bytes);
+    s2c_free_buffer(offsets);
+    s2c_generator_destroy(generator);
+    return 0;
+}
+
+int test_generator_polygons_few_vertices() {
+    printf("Testing nested polygons with few vertices per loop...\n");
+
+    // Edges of coarse loops bulge far inward, so the loops inside must shrink
+    // to stay clear of them
+    int cases[][2] = {{2, 4}, {2, 5}, {2, 6}, {2, 7}, {3, 3}, {8, 4}, {8, 16}};
+    S2CGenerator* generator = s2c_generator_new(5);
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        int depth = cases[c][0];
+        int num_vertices = cases[c][1];
+        char* bytes;
+        int64_t* offsets;
+        ASSERT(s2c_generate_polygons_encoded(generator, 50, num_vertices, depth, 1.0, 1.0, &bytes, &offsets) == 50);
+        for (int i = 0; i < 50; i++) {
+            S2CPolygon* polygon = s2c_polygon_new();
+            ASSERT(s2c_polygon_decode(polygon, bytes + offsets[i], offsets[i + 1] - offsets[i]));
+            S2CError error = {true, NULL};
+            ASSERT(s2c_polygon_is_valid(polygon, &error));
+            ASSERT(s2c_polygon_num_loops(polygon) == depth);
+            s2c_polygon_destroy(polygon);
+        }
+        s2c_free_buffer(bytes);
+        s2c_free_buffer(offsets);
+    }
+
+    // Too deep for the innermost loop to keep distinct vertices
+    double* xyz;
+    int* loop_offsets;
+    int* polygon_offsets;
+    ASSERT(s2c_generate_polygons(generator, 1, 3, 100, 1.0, 1.0, &xyz, &loop_offsets, &polygon_offsets) == 0);
+    ASSERT(xyz == NULL);
+    s2c_generator_destroy(generator);
+    return 0;
+}
+
+int main() {
+    printf("Running generator tests...\n\n");
+
+    if (test_generator_determinism() != 0) return 1;
+    if (test_generator_region_and_clusters() != 0) return 1;
+    if (test_generator_polylines() != 0) return 1;
+    if (test_generator_loops() != 0) return 1;
+    if (test_generator_polygons() != 0) return 1;
+    if (test_generator_polygons_few_vertices() != 0) return 1;
+
+    printf("\nAll generator tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,256 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "s2c.h"
+#include "test_fixtures.h"
+
+#define ASSERT(condition) \
+    if (!(condition)) { \
+        printf("Assertion failed: %s (line %d)\n", #condition, __LINE__); \
+        return 1; \
+    }
+
+int test_arena_handles() {
+    printf("Testing arena-allocated handles...\n");
+
+    S2CArena* arena = s2c_arena_new(1024);
+    ASSERT(s2c_arena_bytes_used(arena) == 0);
+
+    S2CLatLng* latlng = s2c_latlng_from_degrees_arena(arena, 37.0, -122.0);
+    S2CPoint* point = s2c_latlng_to_point_arena(arena, latlng);
+    S2CCellId* leaf = s2c_cellid_from_point_arena(arena, point);
+    S2CCellId* parent = s2c_cellid_parent_arena(arena, leaf, 10);
+    S2CCell* cell = s2c_cell_new_arena(arena, parent);
+    S1CAngle* radius = s1c_angle_from_degrees_arena(arena, 1.0);
+    S2CCap* cap = s2c_cap_from_center_angle_arena(arena, point, radius);
+    ASSERT(latlng && point && leaf && parent && cell && radius && cap);
+
+    // Arena handles work with the regular accessors
+    ASSERT(fabs(s2c_latlng_lat_degrees(latlng) - 37.0) < 1e-9);
+    ASSERT(s2c_cellid_level(parent) == 10);
+    ASSERT(s2c_cap_contains(cap, point));
+    S2CCellId* heap_parent = s2c_cellid_parent(leaf, 10);
+    ASSERT(s2c_cellid_id(heap_parent) == s2c_cellid_id(parent));
+    s2c_cellid_destroy(heap_parent);
+    ASSERT(s2c_arena_bytes_used(arena) > 0);
+
+    // Many allocations spill into additional blocks
+    for (int i = 0; i < 1000; i++) {
+        S2CPoint* p = s2c_point_new_arena(arena, i, 1.0, 0.0);
+        ASSERT(s2c_point_x(p) == i);
+    }
+    size_t reserved = s2c_arena_bytes_reserved(arena);
+    ASSERT(reserved >= s2c_arena_bytes_used(arena));
+
+    // Reset keeps the blocks for reuse
+    s2c_arena_reset(arena);
+    ASSERT(s2c_arena_bytes_used(arena) == 0);
+    for (int i = 0; i < 1000; i++) {
+        s2c_point_new_arena(arena, 0.0, 0.0, 1.0);
+    }
+    ASSERT(s2c_arena_bytes_reserved(arena) == reserved);
+
+    ASSERT(s2c_point_new_arena(NULL, 1.0, 0.0, 0.0) == NULL);
+    s2c_arena_destroy(arena);
+    return 0;
+}
+
+int test_object_pools() {
+    printf("Testing object pool counters...\n");
+
+    uint64_t hits_before = 0, misses_before = 0;
+    s2c_object_pool_stats(S2C_POOL_POINT, &hits_before, &misses_before);
+
+    for (int round = 0; round < 10; round++) {
+        S2CPoint* points[100];
+        for (int i = 0; i < 100; i++) {
+            points[i] = s2c_point_new(i, 0.0, 1.0);
+            ASSERT(s2c_point_x(points[i]) == i);
+        }
+        for (int i = 0; i < 100; i++) {
+            s2c_point_destroy(points[i]);
+        }
+    }
+
+    uint64_t hits = 0, misses = 0;
+    s2c_object_pool_stats(S2C_POOL_POINT, &hits, &misses);
+    if (s2c_object_pools_enabled()) {
+        printf("  Point pool: %llu hits, %llu misses\n",
+               (unsigned long long)(hits - hits_before), (unsigned long long)(misses - misses_before));
+        ASSERT(hits + misses - hits_before - misses_before == 1000);
+        ASSERT(hits - hits_before >= 900);
+    } else {
+        ASSERT(hits == 0 && misses == 0);
+    }
+    return 0;
+}
+
+// Adds n points spread over a band of latitudes as separate shapes
+static void add_points(S2CMutableShapeIndex* index, int n) {
+    for (int i = 0; i < n; i++) {
+        S2CLatLng* latlng = s2c_latlng_from_degrees(-60.0 + (i % 120), -180.0 + 0.7 * i);
+        S2CPoint* point = s2c_latlng_to_point(latlng);
+        s2c_mutable_shape_index_add_point(index, point);
+        s2c_point_destroy(point);
+        s2c_latlng_destroy(latlng);
+    }
+}
+
+int test_memory_tracker() {
+    printf("Testing memory trackers...\n");
+
+    S2CMemoryTracker* tracker = s2c_memory_tracker_new(-1);
+    ASSERT(s2c_memory_tracker_limit(tracker) == -1);
+    ASSERT(s2c_memory_tracker_usage(tracker) == 0);
+
+    S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+    add_points(index, 500);
+    S2CError error = {true, NULL};
+    ASSERT(s2c_mutable_shape_index_force_build_cancellable(index, NULL, &error));
+    ASSERT(s2c_mutable_shape_index_space_used(index) > 0);
+
+    // Attaching charges the built index to the tracker
+    s2c_mutable_shape_index_set_memory_tracker(index, tracker);
+    int64_t usage = s2c_memory_tracker_usage(tracker);
+    printf("  Index uses %lld bytes, tracker reports %lld\n",
+           (long long)s2c_mutable_shape_index_space_used(index), (long long)usage);
+    ASSERT(usage > 0);
+    ASSERT(s2c_memory_tracker_peak_usage(tracker) >= usage);
+
+    s2c_mutable_shape_index_set_memory_tracker(index, NULL);
+    ASSERT(s2c_memory_tracker_usage(tracker) == 0);
+    s2c_mutable_shape_index_destroy(index);
+
+    // A build that would exceed the limit fails instead of allocating
+    s2c_memory_tracker_set_limit(tracker, 1024);
+    ASSERT(s2c_memory_tracker_limit(tracker) == 1024);
+    index = s2c_mutable_shape_index_new();
+    s2c_mutable_shape_index_set_memory_tracker(index, tracker);
+    add_points(index, 500);
+    ASSERT(!s2c_mutable_shape_index_force_build_cancellable(index, NULL, &error));
+    ASSERT(s2c_error_code(&error) == S2C_ERROR_RESOURCE_EXHAUSTED);
+    s2c_free_string(error.text);
+    s2c_mutable_shape_index_destroy(index);
+
+    // An asynchronous build reports the failure through its result
+    index = s2c_mutable_shape_index_new();
+    s2c_mutable_shape_index_set_memory_tracker(index, tracker);
+    add_points(index, 500);
+    S2CTask* build = s2c_mutable_shape_index_force_build_async(index, NULL, NULL, NULL);
+    ASSERT(s2c_task_wait(build, -1) == S2C_TASK_DONE);
+    ASSERT(s2c_task_result(build) == -S2C_ERROR_RESOURCE_EXHAUSTED);
+    s2c_task_destroy(build);
+
+    s2c_mutable_shape_index_destroy(index);
+    ASSERT(s2c_memory_tracker_usage(tracker) == 0);
+    s2c_memory_tracker_destroy(tracker);
+    return 0;
+}
+
+int test_index_usage_sync() {
+    printf("Testing index usage sync and void build errors...\n");
+
+    S2CMemoryTracker* tracker = s2c_memory_tracker_new(-1);
+    S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+    s2c_mutable_shape_index_set_memory_tracker(index, tracker);
+    add_points(index, 20);
+
+    // A small build stays under the periodic callback threshold but is still charged
+    int64_t before_build = s2c_memory_tracker_usage(tracker);
+    s2c_mutable_shape_index_force_build(index);
+    ASSERT(s2c_last_error_code() == S2C_ERROR_OK);
+    int64_t built = s2c_memory_tracker_usage(tracker);
+    printf("  Usage %lld before the build, %lld after\n", (long long)before_build, (long long)built);
+    ASSERT(built > before_build);
+
+    // Minimize releases the index cells
+    s2c_mutable_shape_index_minimize(index);
+    ASSERT(s2c_memory_tracker_usage(tracker) < built);
+    s2c_mutable_shape_index_destroy(index);
+    ASSERT(s2c_memory_tracker_usage(tracker) == 0);
+
+    // Plain builds report an exhausted budget through the last error
+    s2c_memory_tracker_set_limit(tracker, 1024);
+    index = s2c_mutable_shape_index_new();
+    s2c_mutable_shape_index_set_memory_tracker(index, tracker);
+    add_points(index, 500);
+    s2c_mutable_shape_index_force_build(index);
+    ASSERT(s2c_last_error_code() == S2C_ERROR_RESOURCE_EXHAUSTED);
+
+    // and the failure does not stick once the budget allows the build
+    s2c_memory_tracker_set_limit(tracker, -1);
+    s2c_mutable_shape_index_force_build(index);
+    ASSERT(s2c_last_error_code() == S2C_ERROR_OK);
+
+    s2c_mutable_shape_index_destroy(index);
+    ASSERT(s2c_memory_tracker_usage(tracker) == 0);
+    s2c_memory_tracker_destroy(tracker);
+    return 0;
+}
+
+int test_operation_budgets() {
+    printf("Testing memory budgets on builders and operations...\n");
+
+    S2CPolygon* a = fixture_generated_polygon(1, 4096);
+    S2CPolygon* b = fixture_generated_polygon(2, 4096);
+    ASSERT(a && b && s2c_polygon_num_loops(a) == 1 && s2c_polygon_num_loops(b) == 1);
+
+    double* xyz;
+    int* loop_offsets;
+    S2CGenerator* generator = s2c_generator_new(3);
+    ASSERT(s2c_generate_loops(generator, 1, 4096, 1.0, 0.5, &xyz, &loop_offsets) == 1);
+    s2c_generator_destroy(generator);
+
+    S2CMemoryTracker* tracker = s2c_memory_tracker_new(1024);
+    for (int limited = 1; limited >= 0; limited--) {
+        s2c_memory_tracker_set_limit(tracker, limited ? 1024 : -1);
+        int expected = limited ? S2C_ERROR_RESOURCE_EXHAUSTED : S2C_ERROR_OK;
+
+        S2CPolygon* output = s2c_polygon_new();
+        S2CBuilderLayer* layer = s2c_polygon_layer_as_builder_layer(s2c_polygon_layer_new(output));
+        S2CBuilder* builder = s2c_builder_new();
+        s2c_builder_set_memory_tracker(builder, tracker);
+        s2c_builder_start_layer(builder, layer);
+        s2c_builder_add_loops(builder, xyz, loop_offsets, 1);
+        S2CError error = {true, NULL};
+        ASSERT(s2c_builder_build(builder, &error) == !limited);
+        ASSERT(s2c_error_code(&error) == expected);
+        s2c_free_string(error.text);
+        s2c_builder_destroy(builder);
+        s2c_builder_layer_destroy(layer);
+        s2c_polygon_destroy(output);
+
+        S2CPolygon* result = s2c_polygon_new();
+        ASSERT(fixture_union(a, b, tracker, NULL, result) == expected);
+        ASSERT(fixture_buffer(a, tracker, NULL, result) == expected);
+        s2c_polygon_destroy(result);
+
+        // Every operation gives its charge back when destroyed
+        ASSERT(s2c_memory_tracker_usage(tracker) == 0);
+        printf("  Peak usage with %s: %lld bytes\n", limited ? "a 1 KiB limit" : "no limit",
+               (long long)s2c_memory_tracker_peak_usage(tracker));
+        ASSERT(s2c_memory_tracker_peak_usage(tracker) > 0);
+        s2c_memory_tracker_reset_peak_usage(tracker);
+    }
+
+    s2c_memory_tracker_destroy(tracker);
+    s2c_free_buffer(xyz);
+    s2c_free_buffer(loop_offsets);
+    s2c_polygon_destroy(a);
+    s2c_polygon_destroy(b);
+    return 0;
+}
+
+int main() {
+    printf("Running memory management tests...\n\n");
+    
+    if (test_arena_handles() != 0) return 1;
+    if (test_object_pools() != 0) return 1;
+    if (test_memory_tracker() != 0) return 1;
+    if (test_index_usage_sync() != 0) return 1;
+    if (test_operation_budgets() != 0) return 1;
+    
+    printf("\nAll memory management tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "s2c.h"
+
+#define ASSERT(condition) \
+    if (!(condition)) { \
+        printf("Assertion failed: %s (line %d)\n", #condition, __LINE__); \
+        return 1; \
+    }
+
+static void latlng_to_xyz(double lat, double lng, double* xyz) {
+    S2CLatLng* latlng = s2c_latlng_from_degrees(lat, lng);
+    S2CPoint* point = s2c_latlng_to_point(latlng);
+    s2c_point_get_coords(point, &xyz[0], &xyz[1], &xyz[2]);
+    s2c_point_destroy(point);
+    s2c_latlng_destroy(latlng);
+}
+
+// Equator trace of n vertices from lng 0 to 10, shifted north by lat degrees
+static void make_trace(double* xyz, int n, double lat) {
+    for (int i = 0; i < n; i++) {
+        latlng_to_xyz(lat, 10.0 * i / (n - 1), &xyz[3 * i]);
+    }
+}
+
+int test_vertex_alignment() {
+    printf("Testing polyline vertex alignment...\n");
+
+    double a[15], b[15];
+    make_trace(a, 5, 0.0);
+    make_trace(b, 5, 0.0);
+
+    // Identical polylines align along the diagonal at zero cost
+    int warp_path[20];
+    int path_length = 0;
+    double cost = s2c_polyline_exact_vertex_alignment(a, 5, b, 5, warp_path, &path_length);
+    ASSERT(fabs(cost) < 1e-12);
+    ASSERT(path_length == 5);
+    for (int i = 0; i < path_length; i++) {
+        ASSERT(warp_path[2 * i] == i && warp_path[2 * i + 1] == i);
+    }
+
+    // A shifted copy costs more, and the approximate cost is never below the exact one
+    make_trace(b, 5, 1.0);
+    double exact = s2c_polyline_exact_vertex_alignment_cost(a, 5, b, 5);
+    double approx = s2c_polyline_approx_vertex_alignment(a, 5, b, 5, -1, warp_path, &path_length);
+    printf("  Exact cost: %f, approx cost: %f\n", exact, approx);
+    ASSERT(exact > 0);
+    ASSERT(approx >= exact - 1e-12);
+    ASSERT(warp_path[0] == 0 && warp_path[1] == 0);
+    ASSERT(warp_path[2 * (path_length - 1)] == 4 && warp_path[2 * (path_length - 1) + 1] == 4);
+
+    ASSERT(s2c_polyline_exact_vertex_alignment_cost(a, 0, b, 5) < 0);
+    return 0;
+}
+
+int test_medoid_and_consensus() {
+    printf("Testing polyline medoid and consensus...\n");
+
+    // Three traces at lat -1, 0 and 1; the middle one is the medoid
+    double xyz[45];
+    make_trace(&xyz[0], 5, -1.0);
+    make_trace(&xyz[15], 5, 0.0);
+    make_trace(&xyz[30], 5, 1.0);
+    int offsets[] = {0, 5, 10, 15};
+
+    ASSERT(s2c_polyline_medoid(xyz, offsets, 3, false) == 1);
+    ASSERT(s2c_polyline_medoid(xyz, offsets, 3, true) == 1);
+
+    double* consensus = NULL;
+    int count = s2c_polyline_consensus(xyz, offsets, 3, false, true, 0, &consensus);
+    ASSERT(count > 0);
+    ASSERT(consensus != NULL);
+    s2c_free_buffer(consensus);
+
+    // An empty polyline is rejected instead of reaching S2's checks
+    int empty_offsets[] = {0, 5, 5, 10};
+    ASSERT(s2c_polyline_medoid(xyz, empty_offsets, 3, false) == -1);
+    ASSERT(s2c_polyline_consensus(xyz, empty_offsets, 3, false, true, 0, &consensus) == 0);
+    ASSERT(consensus == NULL);
+    return 0;
+}
+
+int test_alignment_cost_matrix() {
+    printf("Testing polyline alignment cost matrix...\n");
+
+    double xyz[60];
+    for (int i = 0; i < 4; i++) {
+        make_trace(&xyz[15 * i], 5, 0.5 * i);
+    }
+    int offsets[] = {0, 5, 10, 15, 20};
+
+    double serial[16], threaded[16];
+    ASSERT(s2c_polyline_alignment_cost_matrix(xyz, offsets, 4, false, 1, serial));
+    ASSERT(s2c_polyline_alignment_cost_matrix(xyz, offsets, 4, false, 3, threaded));
+    int empty_offsets[] = {0, 5, 10, 10, 20};
+    ASSERT(!s2c_polyline_alignment_cost_matrix(xyz, empty_offsets, 4, false, 1, threaded));
+
+    for (int i = 0; i < 4; i++) {
+        ASSERT(serial[i * 4 + i] == 0.0);
+        for (int j = 0; j < 4; j++) {
+            ASSERT(serial[i * 4 + j] == serial[j * 4 + i]);
+            ASSERT(serial[i * 4 + j] == threaded[i * 4 + j]);
+            if (i != j) {
+                ASSERT(fabs(serial[i * 4 + j] -
+                            s2c_polyline_exact_vertex_alignment_cost(&xyz[15 * i], 5, &xyz[15 * j], 5)) < 1e-12);
+            }
+        }
+    }
+    // Traces further apart cost more
+    ASSERT(serial[3] > serial[1]);
+    return 0;
+}
+
+int main() {
+    printf("Running polyline alignment tests...\n\n");
+    
+    if (test_vertex_alignment() != 0) return 1;
+    if (test_medoid_and_consensus() != 0) return 1;
+    if (test_alignment_cost_matrix() != 0) return 1;
+    
+    printf("\nAll polyline alignment tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "s2c.h"
+
+#define ASSERT(condition) \
+    if (!(condition)) { \
+        printf("Assertion failed: %s (line %d)\n", #condition, __LINE__); \
+        return 1; \
+    }
+
+#define DEG_TO_RAD (3.14159265358979323846 / 180.0)
+
+static void latlng_to_xyz(double lat, double lng, double* xyz) {
+    S2CLatLng* latlng = s2c_latlng_from_degrees(lat, lng);
+    S2CPoint* point = s2c_latlng_to_point(latlng);
+    s2c_point_get_coords(point, &xyz[0], &xyz[1], &xyz[2]);
+    s2c_point_destroy(point);
+    s2c_latlng_destroy(latlng);
+}
+
+// Equator trace from lng 0 to 10 with a small wobble in latitude
+static void make_trace(double* xyz, int n, double wobble_degrees) {
+    for (int i = 0; i < n; i++) {
+        double lat = (i % 2 == 0) ? wobble_degrees : -wobble_degrees;
+        latlng_to_xyz(lat, 10.0 * i / (n - 1), &xyz[3 * i]);
+    }
+}
+
+int test_simplify_single_trace() {
+    printf("Testing polyline simplification on a noisy trace...\n");
+    
+    double xyz[3 * 101];
+    make_trace(xyz, 101, 0.001);
+    
+    double out[3 * 101];
+    int count = s2c_polyline_simplify_xyz(xyz, 101, 0.01 * DEG_TO_RAD, out);
+    printf("  Simplified 101 vertices to %d\n", count);
+    ASSERT(count == 2);
+    ASSERT(memcmp(out, xyz, 3 * sizeof(double)) == 0);
+    ASSERT(memcmp(&out[3], &xyz[300], 3 * sizeof(double)) == 0);
+    
+    // A tolerance below the wobble keeps every vertex
+    count = s2c_polyline_simplify_xyz(xyz, 101, 0.0001 * DEG_TO_RAD, out);
+    ASSERT(count == 101);
+    
+    int indices[101];
+    count = s2c_polyline_subsample_vertices_xyz(xyz, 101, 0.01 * DEG_TO_RAD, indices);
+    ASSERT(count == 2);
+    ASSERT(indices[0] == 0);
+    ASSERT(indices[1] == 100);
+    return 0;
+}
+
+int test_simplify_batch() {
+    printf("Testing batch polyline simplification...\n");
+    
+    double xyz[3 * 60];
+    make_trace(xyz, 30, 0.001);
+    make_trace(&xyz[90], 30, 0.5);
+    int offsets[] = {0, 30, 60};
+    
+    double out_xyz[3 * 60];
+    int out_offsets[3];
+    int total = s2c_polylines_simplify_batch(xyz, offsets, 2, 0.01 * DEG_TO_RAD, out_xyz, out_offsets);
+    printf("  Simplified batch to %d vertices\n", total);
+    ASSERT(out_offsets[0] == 0);
+    ASSERT(out_offsets[1] == 2);
+    ASSERT(out_offsets[2] == total);
+    ASSERT(total - out_offsets[1] == 30);
+    
+    int out_indices[60];
+    total = s2c_polylines_subsample_batch(xyz, offsets, 2, 0.01 * DEG_TO_RAD, out_indices, out_offsets);
+    ASSERT(out_offsets[1] == 2);
+    ASSERT(out_indices[1] == 29);
+    ASSERT(total == out_offsets[2]);
+    return 0;
+}
+
+int test_edge_tessellator() {
+    printf("Testing S2EdgeTessellator projection round trip...\n");
+    
+    S2CEdgeTessellator* tessellator = s2c_edge_tessellator_new(S2C_PROJECTION_PLATE_CARREE, 180.0, 0.01 * DEG_TO_RAD);
+    ASSERT(tessellator != NULL);
+    
+    // A long geodesic edge becomes a curve in plate carree coordinates
+    double xyz[6];
+    latlng_to_xyz(0, 0, &xyz[0]);
+    latlng_to_xyz(60, 90, &xyz[3]);
+    double* xy = NULL;
+    int count = s2c_edge_tessellator_project(tessellator, xyz, 2, &xy);
+    printf("  Projected edge has %d vertices\n", count);
+    ASSERT(count > 2);
+    ASSERT(fabs(xy[0]) < 1e-9 && fabs(xy[1]) < 1e-9);
+    ASSERT(fabs(xy[2 * (count - 1)] - 90.0) < 1e-9);
+    ASSERT(fabs(xy[2 * (count - 1) + 1] - 60.0) < 1e-9);
+    s2c_free_buffer(xy);
+    
+    // A straight planar edge becomes a curve on the sphere
+    double planar[] = {0.0, 0.0, 90.0, 60.0};
+    double* out_xyz = NULL;
+    count = s2c_edge_tessellator_unproject(tessellator, planar, 2, &out_xyz);
+    ASSERT(count > 2);
+    ASSERT(fabs(out_xyz[0] - 1.0) < 1e-9);
+    s2c_free_buffer(out_xyz);
+    
+    s2c_edge_tessellator_destroy(tessellator);
+    return 0;
+}
+
+int main() {
+    printf("Running polyline simplification tests...\n\n");
+    
+    if (test_simplify_single_trace() != 0) return 1;
+    if (test_simplify_batch() != 0) return 1;
+    if (test_edge_tessellator() != 0) return 1;
+    
+    printf("\nAll polyline simplification tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,307 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "s2c.h"
+
+#define ASSERT(condition) \
+    if (!(condition)) { \
+        printf("Assertion failed: %s (line %d)\n", #condition, __LINE__); \
+        return 1; \
+    }
+
+static S2CPoint* point_from_degrees(double lat, double lng) {
+    S2CLatLng* latlng = s2c_latlng_from_degrees(lat, lng);
+    S2CPoint* point = s2c_latlng_to_point(latlng);
+    s2c_latlng_destroy(latlng);
+    return point;
+}
+
+// Counter-clockwise square with corners at (lat_lo, lng_lo) and (lat_hi, lng_hi)
+static S2CLoop* make_square(double lat_lo, double lng_lo, double lat_hi, double lng_hi) {
+    const S2CPoint* vertices[4];
+    vertices[0] = point_from_degrees(lat_lo, lng_lo);
+    vertices[1] = point_from_degrees(lat_lo, lng_hi);
+    vertices[2] = point_from_degrees(lat_hi, lng_hi);
+    vertices[3] = point_from_degrees(lat_hi, lng_lo);
+    S2CLoop* loop = s2c_loop_new_from_points(vertices, 4);
+    for (int i = 0; i < 4; i++) s2c_point_destroy((S2CPoint*)vertices[i]);
+    return loop;
+}
+
+int test_mutable_shape_index_basics() {
+    printf("Testing MutableS2ShapeIndex basics...\n");
+
+    S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+    ASSERT(index != NULL);
+    ASSERT(s2c_mutable_shape_index_num_shape_ids(index) == 0);
+
+    S2CLoop* loop = make_square(0, 0, 1, 1);
+    s2c_mutable_shape_index_add_loop(index, loop);
+    S2CPoint* point = point_from_degrees(10, 10);
+    s2c_mutable_shape_index_add_point(index, point);
+
+    ASSERT(s2c_mutable_shape_index_num_shape_ids(index) == 2);
+    ASSERT(s2c_mutable_shape_index_num_edges(index) == 5);
+
+    s2c_point_destroy(point);
+    s2c_loop_destroy(loop);
+    s2c_mutable_shape_index_destroy(index);
+    return 0;
+}
+
+int test_frozen_index() {
+    printf("Testing frozen indexes...\n");
+
+    S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+    S2CLoop* loop = make_square(0, 0, 1, 1);
+    s2c_mutable_shape_index_add_loop(index, loop);
+
+    // Per-thread queries are only handed out once the index is published
+    ASSERT(!s2c_mutable_shape_index_is_frozen(index));
+    ASSERT(s2c_index_thread_local_contains_query(index) == NULL);
+
+    s2c_mutable_shape_index_freeze(index);
+    s2c_mutable_shape_index_freeze(index);
+    ASSERT(s2c_mutable_shape_index_is_frozen(index));
+
+    // Mutations are ignored after freezing
+    s2c_mutable_shape_index_add_loop(index, loop);
+    s2c_mutable_shape_index_minimize(index);
+    ASSERT(s2c_mutable_shape_index_num_shape_ids(index) == 1);
+
+    s2c_loop_destroy(loop);
+    s2c_mutable_shape_index_destroy(index);
+    return 0;
+}
+
+int test_thread_local_queries() {
+    printf("Testing thread-local queries on a frozen index...\n");
+
+    S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+    S2CLoop* loop = make_square(0, 0, 1, 1);
+    s2c_mutable_shape_index_add_loop(index, loop);
+    s2c_mutable_shape_index_freeze(index);
+
+    S2CContainsPointQuery* contains = s2c_index_thread_local_contains_query(index);
+    ASSERT(contains != NULL);
+    ASSERT(s2c_index_thread_local_contains_query(index) == contains);
+
+    S2CPoint* inside = point_from_degrees(0.5, 0.5);
+    S2CPoint* outside = point_from_degrees(5, 5);
+    ASSERT(s2c_contains_point_query_contains(contains, inside));
+    ASSERT(!s2c_contains_point_query_contains(contains, outside));
+
+    S2CClosestEdgeQuery* closest = s2c_index_thread_local_closest_edge_query(index);
+    ASSERT(closest != NULL);
+    S2CClosestEdgeResult* result = s2c_closest_edge_query_find_closest_edge(closest, outside);
+    ASSERT(result != NULL);
+    ASSERT(s2c_closest_edge_result_shape_id(result) == 0);
+    s2c_closest_edge_result_destroy(result);
+
+    S2CCrossingEdgeQuery* crossing = s2c_index_thread_local_crossing_edge_query(index);
+    ASSERT(crossing != NULL);
+    ASSERT(s2c_crossing_edge_query_edge_intersects(crossing, inside, outside));
+
+    // Each index gets its own queries
+    S2CMutableShapeIndex* other = s2c_mutable_shape_index_new();
+    s2c_mutable_shape_index_add_loop(other, loop);
+    s2c_mutable_shape_index_freeze(other);
+    ASSERT(s2c_index_thread_local_contains_query(other) != contains);
+
+    s2c_index_thread_local_release(index);
+    s2c_index_thread_local_release(other);
+    s2c_point_destroy(inside);
+    s2c_point_destroy(outside);
+    s2c_loop_destroy(loop);
+    s2c_mutable_shape_index_destroy(other);
+    s2c_mutable_shape_index_destroy(index);
+    return 0;
+}
+
+int test_thread_pool_batch_queries() {
+    printf("Testing batch point queries on a thread pool...\n");
+
+    S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+    S2CLoop* loop = make_square(0, 0, 10, 10);
+    s2c_mutable_shape_index_add_loop(index, loop);
+    S2CContainsPointQuery* contains = s2c_contains_point_query_new_mutable(index);
+
+    enum { kNumPoints = 3000 };
+    double* xyz = (double*)malloc(sizeof(double) * 3 * kNumPoints);
+    for (int i = 0; i < kNumPoints; i++) {
+        S2CPoint* point = point_from_degrees(-5.0 + (i % 60) * 0.35, -5.0 + (i / 60) * 0.35);
+        s2c_point_get_coords(point, &xyz[3 * i], &xyz[3 * i + 1], &xyz[3 * i + 2]);
+        s2c_point_destroy(point);
+    }
+
+    S2CThreadPool* pool = s2c_thread_pool_new(4, false);
+    ASSERT(s2c_thread_pool_num_threads(pool) == 4);
+    ASSERT(s2c_thread_pool_num_threads(s2c_thread_pool_default()) >= 1);
+
+    uint8_t* inside = (uint8_t*)malloc(kNumPoints);
+    int32_t* shape_ids = (int32_t*)malloc(sizeof(int32_t) * kNumPoints);
+    double* distances = (double*)malloc(sizeof(double) * kNumPoints);
+    ASSERT(s2c_contains_point_query_batch(index, xyz, kNumPoints, pool, inside));
+    ASSERT(s2c_closest_edge_query_batch(index, xyz, kNumPoints, NULL, shape_ids, NULL, distances));
+
+    int num_inside = 0;
+    for (int i = 0; i < kNumPoints; i++) {
+        S2CPoint* point = s2c_point_new(xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2]);
+        ASSERT(inside[i] == s2c_contains_point_query_contains(contains, point));
+        s2c_point_destroy(point);
+        ASSERT(shape_ids[i] == 0);
+        ASSERT(distances[i] >= 0.0);
+        num_inside += inside[i];
+    }
+    printf("  %d of %d points inside\n", num_inside, kNumPoints);
+    ASSERT(num_inside > 0 && num_inside < kNumPoints);
+
+    // An empty index has no closest edges
+    S2CMutableShapeIndex* empty = s2c_mutable_shape_index_new();
+    ASSERT(s2c_closest_edge_query_batch(empty, xyz, 1, pool, shape_ids, NULL, distances));
+    ASSERT(shape_ids[0] == -1);
+    ASSERT(distances[0] == -1.0);
+
+    s2c_thread_pool_destroy(pool);
+    s2c_mutable_shape_index_destroy(empty);
+    free(inside);
+    free(shape_ids);
+    free(distances);
+    free(xyz);
+    s2c_contains_point_query_destroy(contains);
+    s2c_loop_destroy(loop);
+    s2c_mutable_shape_index_destroy(index);
+    return 0;
+}
+
+static void count_completion(S2CTask* task, S2CTaskStatus status, void* user_data) {
+    (void)task;
+    if (status == S2C_TASK_DONE) (*(int*)user_data)++;
+}
+
+int test_async_batches() {
+    printf("Testing asynchronous batch operations...\n");
+
+    S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+    S2CLoop* loop = make_square(0, 0, 10, 10);
+    s2c_mutable_shape_index_add_loop(index, loop);
+
+    int completions = 0;
+    S2CTask* build = s2c_mutable_shape_index_force_build_async(index, NULL, count_completion, &completions);
+    ASSERT(build != NULL);
+    ASSERT(s2c_task_wait(build, -1) == S2C_TASK_DONE);
+    ASSERT(s2c_task_result(build) == 1);
+    s2c_task_destroy(build);
+
+    double xyz[6];
+    S2CPoint* inside = point_from_degrees(5, 5);
+    S2CPoint* outside = point_from_degrees(20, 20);
+    s2c_point_get_coords(inside, &xyz[0], &xyz[1], &xyz[2]);
+    s2c_point_get_coords(outside, &xyz[3], &xyz[4], &xyz[5]);
+    uint8_t contained[2];
+    S2CTask* join = s2c_contains_point_query_batch_async(index, xyz, 2, NULL, contained,
+                                                         count_completion, &completions);
+    ASSERT(s2c_task_wait(join, -1) == S2C_TASK_DONE);
+    ASSERT(s2c_task_result(join) == 1);
+    ASSERT(contained[0] == 1 && contained[1] == 0);
+    ASSERT(!s2c_task_cancel(join));
+    s2c_task_destroy(join);
+
+    // Clip two polygons against a square overlapping the first one
+    S2CLoop* clip_loop = make_square(5, 5, 15, 15);
+    S2CPolygon* clip = s2c_polygon_new_from_loop(clip_loop);
+    S2CLoop* far_loop = make_square(40, 40, 41, 41);
+    S2CPolygon* polygons[2];
+    polygons[0] = s2c_polygon_new_from_loop(loop);
+    polygons[1] = s2c_polygon_new_from_loop(far_loop);
+    S2CPolygon* clipped[2];
+    S2CTask* clip_task = s2c_polygon_intersection_batch_async(clip, polygons, 2, NULL, clipped,
+                                                              count_completion, &completions);
+    ASSERT(s2c_task_wait(clip_task, -1) == S2C_TASK_DONE);
+    ASSERT(s2c_task_result(clip_task) == 2);
+    s2c_task_destroy(clip_task);
+    ASSERT(!s2c_polygon_is_empty(clipped[0]));
+    ASSERT(s2c_polygon_is_empty(clipped[1]));
+
+    // Destroy waits for callbacks, so every completion has been counted
+    ASSERT(completions == 3);
+
+    for (int i = 0; i < 2; i++) {
+        s2c_polygon_destroy(clipped[i]);
+        s2c_polygon_destroy(polygons[i]);
+    }
+    s2c_polygon_destroy(clip);
+    s2c_loop_destroy(far_loop);
+    s2c_loop_destroy(clip_loop);
+    s2c_point_destroy(inside);
+    s2c_point_destroy(outside);
+    s2c_loop_destroy(loop);
+    s2c_mutable_shape_index_destroy(index);
+    return 0;
+}
+
+// Occupies the pool's worker until the gate token is cancelled
+static void hold_worker(S2CTask* task, S2CTaskStatus status, void* user_data) {
+    (void)task;
+    (void)status;
+    while (!s2c_cancel_token_is_cancelled((S2CCancelToken*)user_data)) {
+    }
+}
+
+static void record_status(S2CTask* task, S2CTaskStatus status, void* user_data) {
+    (void)task;
+    *(int*)user_data = (int)status;
+}
+
+int test_cancel_pending_task() {
+    printf("Testing cancellation of queued tasks...\n");
+
+    S2CMutableShapeIndex* index = s2c_mutable_shape_index_new();
+    S2CLoop* loop = make_square(0, 0, 10, 10);
+    s2c_mutable_shape_index_add_loop(index, loop);
+
+    // With one worker held by the first task's callback, later tasks stay queued
+    S2CThreadPool* pool = s2c_thread_pool_new(1, false);
+    S2CCancelToken* gate = s2c_cancel_token_new();
+    S2CTask* blocker = s2c_mutable_shape_index_force_build_async(index, pool, hold_worker, gate);
+    int seen_status = -1;
+    S2CTask* pending = s2c_mutable_shape_index_force_build_async(index, pool, record_status, &seen_status);
+    ASSERT(s2c_task_poll(pending) == S2C_TASK_PENDING);
+    ASSERT(s2c_task_cancel(pending));
+
+    // Destroying a queued task returns at once and drops its callback
+    int completions = 0;
+    S2CTask* dropped = s2c_mutable_shape_index_force_build_async(index, pool, count_completion, &completions);
+    s2c_task_destroy(dropped);
+
+    s2c_cancel_token_cancel(gate);
+    ASSERT(s2c_task_wait(pending, -1) == S2C_TASK_CANCELLED);
+    ASSERT(s2c_task_result(pending) == 0);
+    s2c_task_destroy(pending);
+    ASSERT(seen_status == S2C_TASK_CANCELLED);
+    ASSERT(s2c_task_wait(blocker, -1) == S2C_TASK_DONE);
+    s2c_task_destroy(blocker);
+
+    s2c_thread_pool_destroy(pool);
+    ASSERT(completions == 0);
+
+    s2c_cancel_token_destroy(gate);
+    s2c_loop_destroy(loop);
+    s2c_mutable_shape_index_destroy(index);
+    return 0;
+}
+
+int main() {
+    printf("Running shape index tests...\n\n");
+
+    if (test_mutable_shape_index_basics() != 0) return 1;
+    if (test_frozen_index() != 0) return 1;
+    if (test_thread_local_queries() != 0) return 1;
+    if (test_thread_pool_batch_queries() != 0) return 1;
+    if (test_async_batches() != 0) return 1;
+    if (test_cancel_pending_task() != 0) return 1;
+
+    printf("\nAll shape index tests passed!\n");
+    return 0;
+}
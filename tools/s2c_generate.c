@@ -0,0 +1,218 @@
+// Command line front end for the synthetic workload generators.
+//
+// Writes CSV rows "item,loop,lat,lng" (loop is the loop index within a
+// polygon and 0 otherwise) or, with --format encoded, one record per item:
+// a little-endian uint64 byte length followed by the item's S2 encoding.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "s2c.h"
+
+static const double kDegreesPerRadian = 57.29577951308232;
+
+typedef struct {
+    const char* kind;
+    int64_t count;
+    int vertices;
+    int depth;
+    uint64_t seed;
+    double radius;
+    double roughness;
+    double step;
+    double noise;
+    int clusters;
+    double spread;
+    double overlap;
+    double region_lat;
+    double region_lng;
+    double region_radius;
+    int encoded;
+    const char* output;
+} Options;
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s points|polylines|loops|polygons [options]\n"
+            "  --count N           items to generate (default 1000)\n"
+            "  --vertices N        vertices per polyline or loop (default 64)\n"
+            "  --depth N           loops per polygon: shell, hole, island, ... (default 1)\n"
+            "  --seed N            random seed (default 1)\n"
+            "  --radius DEG        loop and polygon radius (default 0.1)\n"
+            "  --roughness R       fractal detail in [0, 1] (default 0.5)\n"
+            "  --step DEG          polyline step length (default 0.001)\n"
+            "  --noise DEG         polyline vertex noise (default 0.00005)\n"
+            "  --clusters N        cluster centers, 0 for uniform (default 0)\n"
+            "  --spread DEG        cluster standard deviation (default 1)\n"
+            "  --overlap F         fraction of overlapping loops/polygons (default 0)\n"
+            "  --region LAT,LNG,R  cap to generate in (default: whole sphere)\n"
+            "  --format csv|encoded\n"
+            "  --output FILE       (default: stdout)\n",
+            program);
+}
+
+static void latlng_degrees(const double* xyz, double* lat, double* lng) {
+    *lat = atan2(xyz[2], sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1])) * kDegreesPerRadian;
+    *lng = atan2(xyz[1], xyz[0]) * kDegreesPerRadian;
+}
+
+static void write_csv_rows(FILE* out, const double* xyz, int64_t begin, int64_t end, int64_t item, int loop) {
+    for (int64_t i = begin; i < end; i++) {
+        double lat, lng;
+        latlng_degrees(&xyz[3 * i], &lat, &lng);
+        fprintf(out, "%lld,%d,%.9f,%.9f\n", (long long)item, loop, lat, lng);
+    }
+}
+
+static int write_records(FILE* out, const char* bytes, const int64_t* offsets, int count) {
+    for (int i = 0; i < count; i++) {
+        uint64_t length = (uint64_t)(offsets[i + 1] - offsets[i]);
+        unsigned char header[8];
+        for (int b = 0; b < 8; b++) header[b] = (unsigned char)(length >> (8 * b));
+        if (fwrite(header, 1, 8, out) != 8) return 0;
+        if (fwrite(bytes + offsets[i], 1, length, out) != length) return 0;
+    }
+    return 1;
+}
+
+static int parse_args(int argc, char** argv, Options* options) {
+    if (argc < 2) return 0;
+    options->kind = argv[1];
+    for (int i = 2; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return 0;
+        const char* value = argv[++i];
+        if (strcmp(flag, "--count") == 0) options->count = strtoll(value, NULL, 10);
+        else if (strcmp(flag, "--vertices") == 0) options->vertices = atoi(value);
+        else if (strcmp(flag, "--depth") == 0) options->depth = atoi(value);
+        else if (strcmp(flag, "--seed") == 0) options->seed = strtoull(value, NULL, 10);
+        else if (strcmp(flag, "--radius") == 0) options->radius = atof(value);
+        else if (strcmp(flag, "--roughness") == 0) options->roughness = atof(value);
+        else if (strcmp(flag, "--step") == 0) options->step = atof(value);
+        else if (strcmp(flag, "--noise") == 0) options->noise = atof(value);
+        else if (strcmp(flag, "--clusters") == 0) options->clusters = atoi(value);
+        else if (strcmp(flag, "--spread") == 0) options->spread = atof(value);
+        else if (strcmp(flag, "--overlap") == 0) options->overlap = atof(value);
+        else if (strcmp(flag, "--output") == 0) options->output = value;
+        else if (strcmp(flag, "--region") == 0) {
+            if (sscanf(value, "%lf,%lf,%lf", &options->region_lat, &options->region_lng,
+                       &options->region_radius) != 3) {
+                return 0;
+            }
+        } else if (strcmp(flag, "--format") == 0) {
+            if (strcmp(value, "encoded") == 0) options->encoded = 1;
+            else if (strcmp(value, "csv") == 0) options->encoded = 0;
+            else return 0;
+        } else {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Generates and writes one batch; returns the number of items or -1 on error
+static int64_t generate_batch(S2CGenerator* generator, const Options* options, int count, int64_t first,
+                              FILE* out) {
+    const char* kind = options->kind;
+    int is_polylines = strcmp(kind, "polylines") == 0;
+    int is_loops = strcmp(kind, "loops") == 0;
+    int is_polygons = strcmp(kind, "polygons") == 0;
+
+    if (strcmp(kind, "points") == 0) {
+        if (options->encoded) return -1;
+        double* xyz;
+        int64_t n = s2c_generate_points(generator, count, &xyz);
+        for (int64_t i = 0; i < n; i++) write_csv_rows(out, xyz, i, i + 1, first + i, 0);
+        s2c_free_buffer(xyz);
+        return n;
+    }
+    if (!is_polylines && !is_loops && !is_polygons) return -1;
+
+    if (options->encoded) {
+        char* bytes;
+        int64_t* offsets;
+        int n;
+        if (is_polylines) {
+            n = s2c_generate_polylines_encoded(generator, count, options->vertices, options->step,
+                                               options->noise, &bytes, &offsets);
+        } else if (is_loops) {
+            n = s2c_generate_loops_encoded(generator, count, options->vertices, options->radius,
+                                           options->roughness, &bytes, &offsets);
+        } else {
+            n = s2c_generate_polygons_encoded(generator, count, options->vertices, options->depth,
+                                              options->radius, options->roughness, &bytes, &offsets);
+        }
+        int ok = n > 0 && write_records(out, bytes, offsets, n);
+        s2c_free_buffer(bytes);
+        s2c_free_buffer(offsets);
+        return ok ? n : -1;
+    }
+
+    double* xyz;
+    int* offsets;
+    int* polygon_offsets = NULL;
+    int n;
+    if (is_polylines) {
+        n = s2c_generate_polylines(generator, count, options->vertices, options->step, options->noise,
+                                   &xyz, &offsets);
+    } else if (is_loops) {
+        n = s2c_generate_loops(generator, count, options->vertices, options->radius, options->roughness,
+                               &xyz, &offsets);
+    } else {
+        n = s2c_generate_polygons(generator, count, options->vertices, options->depth, options->radius,
+                                  options->roughness, &xyz, &offsets, &polygon_offsets);
+    }
+    for (int i = 0; i < n; i++) {
+        if (polygon_offsets) {
+            for (int k = polygon_offsets[i]; k < polygon_offsets[i + 1]; k++) {
+                write_csv_rows(out, xyz, offsets[k], offsets[k + 1], first + i, k - polygon_offsets[i]);
+            }
+        } else {
+            write_csv_rows(out, xyz, offsets[i], offsets[i + 1], first + i, 0);
+        }
+    }
+    s2c_free_buffer(xyz);
+    s2c_free_buffer(offsets);
+    s2c_free_buffer(polygon_offsets);
+    return n > 0 ? n : -1;
+}
+
+int main(int argc, char** argv) {
+    // Items are generated in batches so memory stays bounded at any count;
+    // overlap and spacing are arranged within each batch
+    enum { kBatchSize = 1 << 16 };
+
+    Options options = {NULL, 1000, 64, 1, 1, 0.1, 0.5, 0.001, 0.00005, 0, 1.0, 0.0, 0.0, 0.0, 180.0, 0, NULL};
+    if (!parse_args(argc, argv, &options)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    FILE* out = stdout;
+    if (options.output && !(out = fopen(options.output, "wb"))) {
+        perror(options.output);
+        return 1;
+    }
+
+    S2CGenerator* generator = s2c_generator_new(options.seed);
+    s2c_generator_set_region(generator, options.region_lat, options.region_lng, options.region_radius);
+    s2c_generator_set_clustering(generator, options.clusters, options.spread);
+    s2c_generator_set_overlap(generator, options.overlap);
+
+    int status = 0;
+    for (int64_t done = 0; done < options.count;) {
+        int64_t remaining = options.count - done;
+        int count = remaining < kBatchSize ? (int)remaining : kBatchSize;
+        int64_t n = generate_batch(generator, &options, count, done, out);
+        if (n <= 0) {
+            fprintf(stderr, "%s: cannot generate %s with these options\n", argv[0], options.kind);
+            status = 1;
+            break;
+        }
+        done += n;
+    }
+
+    s2c_generator_destroy(generator);
+    if (out != stdout) fclose(out);
+    return status;
+}